@@ -0,0 +1,254 @@
+/**
+ * @file sd_bench.cpp
+ * @brief Throughput and latency benchmark of <code>sd::solve()</code> over puzzle corpora.
+ *
+ * <p>
+ * Usage: <code>sd_bench [-r repeats] [-e engine] [-d deduction] [-b branching] [--csv] [corpus ...]</code>
+ * </p>
+ * <p>
+ * Every corpus (one 81-character puzzle per line) is solved under every
+ * selected combination of search engine, deduction level and branching
+ * strategy. Each combination gets one untimed warm-up pass and then
+ * <code>repeats</code> timed passes. For every row it reports puzzles per
+ * second, per-puzzle p50 / p99 / max latency and the mean and maximum search
+ * nodes (<code>SolverWorkspace::nodes</code>). Parsing is done once, outside
+ * the timed region.
+ * </p>
+ * <p>
+ * Corpora must hold solvable puzzles only, as the bundled ones do. Every solve
+ * is checked outside the timed region. It must succeed, its grid must be
+ * complete, every row, column and box must hold each digit once, and the
+ * givens must be kept. Failed solves and wrong grids are reported on
+ * <code>stderr</code> and make the exit status 1.
+ * </p>
+ * <p>
+ * <code>-e</code>, <code>-d</code> and <code>-b</code> take one name or
+ * <code>all</code> (the default). Without corpus arguments the bundled
+ * <code>bench/corpora</code> sets are used.
+ * </p>
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sudok_solver.hpp"
+
+#ifndef SUDOKLITE_BENCH_CORPORA
+#define SUDOKLITE_BENCH_CORPORA "bench/corpora"
+#endif
+
+namespace {
+    struct Corpus {
+        std::string name;
+        std::vector<sd::Board> puzzles;
+    };
+
+    struct Config {
+        sd::SolveOptions options;
+        const char *engine;
+        const char *deduction;
+        const char *branching;
+    };
+
+    struct Result {
+        std::size_t puzzles = 0;
+        std::size_t solved = 0;
+        std::size_t wrong = 0; ///< Solves that failed or returned a grid that is not a solution
+        double seconds = 0;
+        double p50_us = 0, p99_us = 0, max_us = 0;
+        double nodes_mean = 0;
+        uint64_t nodes_max = 0;
+    };
+
+    constexpr const char *engine_names[] = {"copy", "trail", "dlx", "auto"};
+    constexpr const char *deduction_names[] = {"naked", "hidden", "pairs"};
+    constexpr const char *branching_names[] = {"linear", "mrv", "mrv_degree", "unit_digit"};
+
+    /// Index of <code>name</code> in <code>names</code>, <code>count</code> for "all", -1 if unknown
+    template<std::size_t N>
+    int parse_choice(const char *name, const char *const (&names)[N]) {
+        if (std::strcmp(name, "all") == 0) return static_cast<int>(N);
+        for (std::size_t i = 0; i < N; ++i)
+            if (std::strcmp(name, names[i]) == 0) return static_cast<int>(i);
+        return -1;
+    }
+
+    bool load_corpus(const std::string &path, Corpus &corpus) {
+        std::ifstream in(path);
+        if (!in) return false;
+        const std::size_t slash = path.find_last_of("/\\");
+        corpus.name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.size() < 81) continue;
+            sd::Board board{};
+            board.load(line.c_str());
+            corpus.puzzles.push_back(board);
+        }
+        return true;
+    }
+
+    /// Digit bit of a confirmed cell, 0 otherwise
+    uint16_t placed_bit(const sd::Board::cell_type &cell) {
+        const uint16_t mask = cell.possibleMask();
+        return cell.isConfirmed() && (mask & (mask - 1)) == 0 ? mask : 0;
+    }
+
+    /// Whether <code>board</code> is a complete, valid grid that keeps the givens of <code>puzzle</code>
+    bool is_solution_of(const sd::Board &board, const sd::Board &puzzle) {
+        constexpr uint16_t all_digits = 0b1111111110;
+        for (uint8_t i = 0; i < 9; ++i) {
+            uint16_t row = 0, col = 0, box = 0;
+            for (uint8_t j = 0; j < 9; ++j) {
+                row |= placed_bit(board.cells[i * 9 + j]);
+                col |= placed_bit(board.cells[j * 9 + i]);
+                box |= placed_bit(board.cells[(i / 3 * 3 + j / 3) * 9 + i % 3 * 3 + j % 3]);
+            }
+            if (row != all_digits || col != all_digits || box != all_digits) return false;
+        }
+        for (uint8_t i = 0; i < 81; ++i)
+            if (puzzle.cells[i].isConfirmed() && placed_bit(board.cells[i]) != puzzle.cells[i].possibleMask())
+                return false;
+        return true;
+    }
+
+    /// Nearest-rank percentile of sorted samples
+    double percentile(const std::vector<uint64_t> &sorted, const unsigned p) {
+        if (sorted.empty()) return 0;
+        std::size_t rank = (sorted.size() * p + 99) / 100;
+        if (rank == 0) rank = 1;
+        return static_cast<double>(sorted[rank - 1]) / 1000.0;
+    }
+
+    Result run(const Corpus &corpus, const Config &config, const unsigned repeats, sd::SolverWorkspace &ws) {
+        using clock = std::chrono::steady_clock;
+        Result result{};
+        std::vector<uint64_t> samples;
+        samples.reserve(corpus.puzzles.size() * repeats);
+        uint64_t nodes_total = 0;
+
+        for (unsigned pass = 0; pass <= repeats; ++pass) {
+            const bool timed = pass != 0; // pass 0 warms caches and the branch predictor
+            for (const sd::Board &puzzle: corpus.puzzles) {
+                sd::Board board = puzzle;
+                const auto start = clock::now();
+                const bool ok = sd::solve(board, ws, config.options);
+                const auto elapsed = clock::now() - start;
+                if (!ok || !is_solution_of(board, puzzle)) ++result.wrong;
+                if (!timed) continue;
+                samples.push_back(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+                result.solved += ok;
+                nodes_total += ws.nodes;
+                result.nodes_max = std::max(result.nodes_max, ws.nodes);
+            }
+        }
+
+        result.puzzles = samples.size();
+        for (const uint64_t ns: samples) result.seconds += static_cast<double>(ns) * 1e-9;
+        std::sort(samples.begin(), samples.end());
+        result.p50_us = percentile(samples, 50);
+        result.p99_us = percentile(samples, 99);
+        result.max_us = samples.empty() ? 0 : static_cast<double>(samples.back()) / 1000.0;
+        result.nodes_mean = result.puzzles ? static_cast<double>(nodes_total) / static_cast<double>(result.puzzles) : 0;
+        return result;
+    }
+
+    int usage(const char *program) {
+        std::fprintf(stderr,
+                     "usage: %s [-r repeats] [-e copy|trail|dlx|auto|all] [-d naked|hidden|pairs|all]\n"
+                     "       [-b linear|mrv|mrv_degree|unit_digit|all] [--csv] [corpus ...]\n", program);
+        return 2;
+    }
+}
+
+int main(int argc, char **argv) {
+    unsigned repeats = 3;
+    int engine = 4, deduction = 3, branching = 4; // "all"
+    bool csv = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (std::strcmp(arg, "--csv") == 0) {
+            csv = true;
+        } else if (arg[0] == '-' && arg[1] != '\0' && arg[2] == '\0' && i + 1 < argc) {
+            const char *value = argv[++i];
+            switch (arg[1]) {
+                case 'r': repeats = static_cast<unsigned>(std::strtoul(value, nullptr, 10)); break;
+                case 'e': engine = parse_choice(value, engine_names); break;
+                case 'd': deduction = parse_choice(value, deduction_names); break;
+                case 'b': branching = parse_choice(value, branching_names); break;
+                default: return usage(argv[0]);
+            }
+            if (engine < 0 || deduction < 0 || branching < 0) return usage(argv[0]);
+        } else if (arg[0] != '-') {
+            paths.emplace_back(arg);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (repeats == 0) repeats = 1;
+    if (paths.empty())
+        for (const char *name: {"easy.txt", "17clue.txt", "hardest.txt"})
+            paths.push_back(std::string(SUDOKLITE_BENCH_CORPORA) + "/" + name);
+
+    std::vector<Corpus> corpora;
+    for (const std::string &path: paths) {
+        Corpus corpus;
+        if (!load_corpus(path, corpus)) {
+            std::perror(path.c_str());
+            return 1;
+        }
+        corpora.push_back(std::move(corpus));
+    }
+
+    std::vector<Config> configs;
+    for (int e = 0; e < 4; ++e) {
+        if (engine != 4 && engine != e) continue;
+        for (int d = 0; d < 3; ++d) {
+            if (deduction != 3 && deduction != d) continue;
+            for (int b = 0; b < 4; ++b) {
+                if (branching != 4 && branching != b) continue;
+                sd::SolveOptions options{};
+                options.engine = static_cast<sd::SearchEngine>(e);
+                options.deduction = static_cast<sd::DeductionLevel>(d);
+                options.branching = static_cast<sd::Branching>(b);
+                configs.push_back({options, engine_names[e], deduction_names[d], branching_names[b]});
+            }
+        }
+    }
+
+    static sd::SolverWorkspace ws{};
+    if (csv)
+        std::printf("corpus,engine,deduction,branching,puzzles,solved,puzzles_per_sec,"
+                    "p50_us,p99_us,max_us,nodes_mean,nodes_max\n");
+    else
+        std::printf("%-12s %-6s %-7s %-11s %8s %8s %11s %9s %9s %10s %10s %9s\n", "corpus", "engine", "deduce",
+                    "branching", "puzzles", "solved", "puzzles/s", "p50 us", "p99 us", "max us", "nodes avg",
+                    "nodes max");
+
+    bool failed = false;
+    for (const Corpus &corpus: corpora) {
+        for (const Config &config: configs) {
+            const Result r = run(corpus, config, repeats, ws);
+            const double rate = r.seconds > 0 ? static_cast<double>(r.puzzles) / r.seconds : 0;
+            std::printf(csv ? "%s,%s,%s,%s,%zu,%zu,%.0f,%.2f,%.2f,%.2f,%.2f,%llu\n"
+                            : "%-12s %-6s %-7s %-11s %8zu %8zu %11.0f %9.2f %9.2f %10.2f %10.2f %9llu\n",
+                        corpus.name.c_str(), config.engine, config.deduction, config.branching, r.puzzles, r.solved,
+                        rate, r.p50_us, r.p99_us, r.max_us, r.nodes_mean, static_cast<unsigned long long>(r.nodes_max));
+            std::fflush(stdout);
+            if (r.wrong) {
+                std::fprintf(stderr, "%s %s %s %s: %zu solves failed or wrong\n", corpus.name.c_str(), config.engine,
+                             config.deduction, config.branching, r.wrong);
+                failed = true;
+            }
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -1,7 +1,18 @@
 # cython: language_level=3
 import numpy as np
 cimport numpy as np
-from sd_solver_c cimport sudoku_solver_c, sudoku_puzzle_t
+from libc.stdint cimport uint8_t
+from libc.string cimport memcpy
+from sd_solver_c cimport sudoku_puzzle_t
+from sd_solver_c cimport sd_status_t, SD_STATUS_SOLVED, SD_STATUS_INVALID_SIZE
+from sd_solver_c cimport sudoku_solve_c, sudoku_status_message
+from sd_solver_c cimport sudoku_stats_t, sudoku_solve_stats, sudoku_solve_limited
+from sd_solver_c cimport sudoku_count_solutions, sudoku_has_unique_solution
+from sd_solver_c cimport sudoku_triage_t, sudoku_triage
+from sd_solver_c cimport sudoku_candidates_t, sudoku_candidate_update_t
+from sd_solver_c cimport sudoku_candidates_init, sudoku_candidates_place
+from sd_solver_c cimport sudoku_generate
+from sd_solver_c cimport sudoku_solve_batch, sudoku_solve_batch_parallel
 
 def solve(np.ndarray[np.int8_t, ndim=1, mode="c"] puzzle):
     """
@@ -19,25 +30,295 @@ def solve(np.ndarray[np.int8_t, ndim=1, mode="c"] puzzle):
     np.ndarray[int8]
         Solved 9x9 Sudoku puzzle.
     """
-    if puzzle.size < 81:
-        raise ValueError("puzzle must have at least 81 elements")
-
     # --- copy puzzle data into the struct ---
     cdef sudoku_puzzle_t sp
-    for i in range(81):
-        sp.data[i] = <signed char> puzzle[i]
+    _to_puzzle(puzzle, &sp)
 
     # --- call the C API ---
-    cdef const char *result = sudoku_solver_c(&sp)
+    cdef sd_status_t status = sudoku_solve_c(&sp)
 
-    # --- interpret return message ---
-    msg = result.decode("utf-8") if hasattr(result, "decode") else result
-    if msg != "Solved":
+    # --- interpret status code; the message is only decoded on failure ---
+    if status != SD_STATUS_SOLVED:
+        msg = sudoku_status_message(status).decode("utf-8")
         raise RuntimeError(f"Sudoku solver failed: {msg}")
 
     # --- convert back to numpy array ---
-    solved = np.empty(81, dtype=np.int8)
-    for i in range(81):
-        solved[i] = sp.data[i]
+    return _from_puzzle(&sp).reshape((9, 9))
+
+
+cdef int _to_puzzle(const signed char[::1] puzzle, sudoku_puzzle_t *sp) except -1:
+    if puzzle.shape[0] < 81:
+        raise ValueError("puzzle must have at least 81 elements")
+    memcpy(sp.data, &puzzle[0], 81)
+    return 0
+
+
+cdef np.ndarray _from_puzzle(const sudoku_puzzle_t *sp):
+    out = np.empty(81, dtype=np.int8)
+    cdef signed char[::1] cells = out
+    memcpy(&cells[0], sp.data, 81)
+    return out
+
+
+def solve_with_stats(np.ndarray[np.int8_t, ndim=1, mode="c"] puzzle):
+    """
+    Solve a 9x9 Sudoku puzzle and report what the search did.
+
+    Parameters
+    ----------
+    puzzle : np.ndarray[int8]
+        1D array of length 81 (0 = empty, 1~9 = given digits). Not modified.
+
+    Returns
+    -------
+    tuple[np.ndarray[int8], dict]
+        The solved 9x9 puzzle and the search counters: ``guesses``,
+        ``backtracks``, ``contradictions``, ``propagations``, ``solutions``,
+        ``max_depth``, ``deduce_cycles`` and ``branch_cycles`` (the last two
+        are 0 unless built with ``SD_ENABLE_CYCLE_TIMERS=1``).
+    """
+    cdef sudoku_puzzle_t sp
+    cdef sudoku_stats_t st
+    _to_puzzle(puzzle, &sp)
+
+    cdef sd_status_t status
+    with nogil:
+        status = sudoku_solve_stats(&sp, &st)
+    if status != SD_STATUS_SOLVED:
+        msg = sudoku_status_message(status).decode("utf-8")
+        raise RuntimeError(f"Sudoku solver failed: {msg}")
+
+    return _from_puzzle(&sp).reshape((9, 9)), st
+
+
+def count_solutions(np.ndarray[np.int8_t, ndim=1, mode="c"] puzzle, unsigned int limit=2):
+    """
+    Count the solutions of a 9x9 Sudoku puzzle, up to ``limit``.
+
+    Parameters
+    ----------
+    puzzle : np.ndarray[int8]
+        1D array of length 81 (0 = empty, 1~9 = given digits). Not modified.
+    limit : int
+        Stop searching once this many solutions are found.
+
+    Returns
+    -------
+    int
+        Number of solutions found (0 for contradictory givens), at most ``limit``.
+    """
+    cdef sudoku_puzzle_t sp
+    _to_puzzle(puzzle, &sp)
+    return sudoku_count_solutions(&sp, limit)
+
+
+def has_unique_solution(np.ndarray[np.int8_t, ndim=1, mode="c"] puzzle):
+    """
+    Return True if the 9x9 Sudoku puzzle has exactly one solution.
+    """
+    cdef sudoku_puzzle_t sp
+    _to_puzzle(puzzle, &sp)
+    return sudoku_has_unique_solution(&sp) != 0
+
+
+_VERDICTS = ("open", "unique", "ambiguous", "invalid", "unsolvable")
+_DIFFICULTIES = ("naked_singles", "hidden_singles", "pairs", "search")
+
+
+def triage(np.ndarray[np.int8_t, ndim=1, mode="c"] puzzle):
+    """
+    Classify a 9x9 Sudoku puzzle from deduction alone, without searching.
+
+    Parameters
+    ----------
+    puzzle : np.ndarray[int8]
+        1D array of length 81 (0 = empty, 1~9 = given digits). Not modified.
+
+    Returns
+    -------
+    dict
+        ``verdict`` ("open", "unique", "ambiguous", "invalid" or
+        "unsolvable"), ``difficulty`` ("naked_singles", "hidden_singles",
+        "pairs" or "search"), ``clues``, ``digits`` (distinct given digits)
+        and ``open_cells`` (cells deduction left undecided).
+    """
+    cdef sudoku_puzzle_t sp
+    cdef sudoku_triage_t t
+    _to_puzzle(puzzle, &sp)
+    with nogil:
+        sudoku_triage(&sp, &t)
+    return {"verdict": _VERDICTS[t.verdict], "difficulty": _DIFFICULTIES[t.difficulty],
+            "clues": t.clues, "digits": t.digits, "open_cells": t.open_cells}
+
+
+cdef list _mask_digits(unsigned int mask):
+    return [d for d in range(1, 10) if mask >> d & 1]
+
+
+cdef class CandidateGrid:
+    """
+    Live pencil-mark grid for interactive frontends.
+
+    Placing or clearing a digit updates the candidates of the cell's peers by
+    elimination alone, in well under a microsecond, instead of re-solving the
+    puzzle after every keystroke.
+
+    Parameters
+    ----------
+    puzzle : np.ndarray[int8], optional
+        1D array of length 81 (0 = empty, 1~9 = given digits); empty grid if omitted.
+    """
+    cdef sudoku_candidates_t grid
+
+    def __init__(self, puzzle=None):
+        cdef sudoku_puzzle_t sp
+        if puzzle is None:
+            sudoku_candidates_init(&self.grid, NULL)
+        else:
+            _to_puzzle(np.ascontiguousarray(puzzle, dtype=np.int8), &sp)  # a copy only if not int8 already
+            sudoku_candidates_init(&self.grid, &sp)
+
+    def place(self, unsigned int cell, unsigned int digit):
+        """
+        Put ``digit`` (1~9) in ``cell`` (0~80, row-major); 0 clears the cell.
+
+        Returns
+        -------
+        tuple[bool, dict[int, list[int]]]
+            Whether the touched cells are still consistent (no repeated digit,
+            no cell without candidates), and the new candidates of every cell
+            the edit changed (the placed digit alone for a filled cell).
+        """
+        if cell >= 81 or digit > 9:
+            raise ValueError("cell must be 0~80 and digit 0~9")
+        cdef sudoku_candidate_update_t update
+        sudoku_candidates_place(&self.grid, <uint8_t> cell, <uint8_t> digit, &update)
+        changes = {update.cells[i]: _mask_digits(update.masks[i]) for i in range(update.count)}
+        return update.consistent != 0, changes
+
+    def remove(self, unsigned int cell):
+        """
+        Clear ``cell``; same return value as ``place``.
+        """
+        return self.place(cell, 0)
+
+    def candidates(self, unsigned int cell):
+        """
+        Candidates of an empty ``cell``, or ``[digit]`` for a filled one.
+        """
+        if cell >= 81:
+            raise ValueError("cell must be 0~80")
+        return _mask_digits(self.grid.cells[cell])
+
+    def digit(self, unsigned int cell):
+        """
+        Digit placed in ``cell``; 0 if it is empty.
+        """
+        if cell >= 81:
+            raise ValueError("cell must be 0~80")
+        cdef unsigned int state = self.grid.cells[cell]
+        return _mask_digits(state)[0] if state & 1 else 0
+
+
+def generate(unsigned long long seed=0, unsigned int target_clues=0, unsigned int min_guesses=0):
+    """
+    Generate a 9x9 Sudoku puzzle with a unique solution.
+
+    Parameters
+    ----------
+    seed : int
+        Random seed; the same seed always yields the same puzzle.
+    target_clues : int
+        Stop removing clues at this count; 0 reduces to a minimal puzzle.
+    min_guesses : int
+        Reject puzzles the solver finishes in fewer search nodes; 0 accepts any.
+
+    Returns
+    -------
+    tuple[np.ndarray[int8], np.ndarray[int8]]
+        ``(puzzle, solution)``, both flat arrays of length 81 (0 = empty cell).
+    """
+    cdef sudoku_puzzle_t sp
+    cdef sudoku_puzzle_t sol
+    if sudoku_generate(&sp, &sol, seed, target_clues, min_guesses) == 0:
+        raise RuntimeError("Sudoku generator failed to meet min_guesses")
+    return _from_puzzle(&sp), _from_puzzle(&sol)
+
+
+def solve_inplace(signed char[::1] puzzle, unsigned long long max_nodes=0, unsigned long long timeout_us=0):
+    """
+    Solve a 9x9 Sudoku puzzle in place, without copying and without the GIL.
+
+    Parameters
+    ----------
+    puzzle : np.ndarray[int8]
+        C-contiguous buffer of exactly 81 cells (0 = empty, 1~9 = given digits),
+        overwritten with the solution on success. Pass ``grid.reshape(-1)`` for
+        a contiguous 9x9 array.
+    max_nodes : int
+        Give up after this many search guesses; 0 = no limit.
+    timeout_us : int
+        Give up after this many microseconds; 0 = no limit.
+
+    Returns
+    -------
+    int
+        Status code: 0 = solved, 1 = invalid size, 2 = invalid puzzle,
+        3 = unsolvable, 4 = limit reached (``puzzle`` left unchanged).
+    """
+    if puzzle.shape[0] != 81:
+        return SD_STATUS_INVALID_SIZE
+    cdef sd_status_t status
+    with nogil:
+        if max_nodes or timeout_us:
+            status = sudoku_solve_limited(<sudoku_puzzle_t *> &puzzle[0], max_nodes, timeout_us)
+        else:
+            status = sudoku_solve_c(<sudoku_puzzle_t *> &puzzle[0])
+    return <int> status
+
+
+def solve_batch(np.ndarray puzzles, unsigned int threads=1, size_t chunk=16):
+    """
+    Solve a batch of 9x9 Sudoku puzzles in place with one native call.
+
+    The whole buffer is handed to the native batch solver with the GIL released;
+    no element is copied. With ``threads != 1`` the batch is spread over worker
+    threads (0 = all hardware threads), each claiming ``chunk`` puzzles at a time.
+
+    Parameters
+    ----------
+    puzzles : np.ndarray[int8]
+        C-contiguous array of shape ``(N, 81)`` or ``(N, 9, 9)``; solved puzzles
+        are overwritten with their solution.
+    threads : int
+        Worker count including the calling thread; 1 solves on the calling thread.
+    chunk : int
+        Puzzles claimed per scheduling step when running on several threads.
+
+    Returns
+    -------
+    np.ndarray[intc]
+        Status code per puzzle (0 = solved, see ``solve_inplace``).
+    """
+    if puzzles.dtype != np.int8 or not puzzles.flags.c_contiguous:
+        raise ValueError("puzzles must be a C-contiguous int8 array")
+    if not ((puzzles.ndim == 2 and puzzles.shape[1] == 81) or
+            (puzzles.ndim == 3 and puzzles.shape[1] == 9 and puzzles.shape[2] == 9)):
+        raise ValueError("puzzles must have shape (N, 81) or (N, 9, 9)")
+
+    cdef size_t n = puzzles.shape[0]
+    cdef signed char[:, ::1] cells = puzzles.reshape(n, 81)  # a view: the layout is already contiguous
+    # sd_status_t is an int-sized C enum, so an intc array is its exact layout
+    statuses = np.empty(n, dtype=np.intc)
+    cdef int[::1] out = statuses
+    if n == 0:
+        return statuses
 
-    return solved.reshape((9, 9))
+    cdef sudoku_puzzle_t *data = <sudoku_puzzle_t *> &cells[0, 0]
+    cdef sd_status_t *status_data = <sd_status_t *> &out[0]
+    with nogil:
+        if threads == 1:
+            sudoku_solve_batch(data, n, status_data)
+        else:
+            sudoku_solve_batch_parallel(data, n, status_data, threads, chunk)
+    return statuses
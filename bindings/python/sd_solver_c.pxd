@@ -1,6 +1,64 @@
 # sd_solver_c.pxd
-cdef extern from "sd_c_api.h":
+from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t
+
+# Every entry point works on caller-owned buffers only, so all may run without the GIL.
+cdef extern from "sd_c_api.h" nogil:
     ctypedef struct sudoku_puzzle_t:
         signed char data[81]
 
+    ctypedef enum sd_status_t:
+        SD_STATUS_SOLVED
+        SD_STATUS_INVALID_SIZE
+        SD_STATUS_INVALID_PUZZLE
+        SD_STATUS_UNSOLVABLE
+        SD_STATUS_LIMIT_REACHED
+
+    ctypedef struct sudoku_stats_t:
+        uint64_t guesses
+        uint64_t backtracks
+        uint64_t contradictions
+        uint64_t propagations
+        uint64_t solutions
+        uint64_t max_depth
+        uint64_t deduce_cycles
+        uint64_t branch_cycles
+
+    ctypedef enum sd_verdict_t:
+        SD_VERDICT_OPEN
+        SD_VERDICT_UNIQUE
+        SD_VERDICT_AMBIGUOUS
+        SD_VERDICT_INVALID
+        SD_VERDICT_UNSOLVABLE
+
+    ctypedef struct sudoku_triage_t:
+        uint8_t verdict
+        uint8_t difficulty
+        uint16_t clues
+        uint8_t digits
+        uint16_t open_cells
+
+    ctypedef struct sudoku_candidates_t:
+        uint16_t cells[81]
+
+    ctypedef struct sudoku_candidate_update_t:
+        uint8_t consistent
+        uint8_t count
+        uint8_t cells[21]
+        uint16_t masks[21]
+
     const char *sudoku_solver_c(sudoku_puzzle_t *puzzle)
+    sd_status_t sudoku_solve_c(sudoku_puzzle_t *puzzle)
+    sd_status_t sudoku_solve_stats(sudoku_puzzle_t *puzzle, sudoku_stats_t *stats)
+    sd_status_t sudoku_solve_limited(sudoku_puzzle_t *puzzle, uint64_t max_nodes, uint64_t timeout_us)
+    const char *sudoku_status_message(sd_status_t status)
+    uint32_t sudoku_count_solutions(const sudoku_puzzle_t *puzzle, uint32_t limit)
+    int sudoku_has_unique_solution(const sudoku_puzzle_t *puzzle)
+    sd_verdict_t sudoku_triage(const sudoku_puzzle_t *puzzle, sudoku_triage_t *out)
+    void sudoku_candidates_init(sudoku_candidates_t *grid, const sudoku_puzzle_t *puzzle)
+    int sudoku_candidates_place(sudoku_candidates_t *grid, uint8_t cell, uint8_t digit,
+                                sudoku_candidate_update_t *update)
+    uint32_t sudoku_generate(sudoku_puzzle_t *puzzle, sudoku_puzzle_t *solution, uint64_t seed,
+                             uint32_t target_clues, uint32_t min_guesses)
+    size_t sudoku_solve_batch(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status)
+    size_t sudoku_solve_batch_parallel(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status,
+                                       unsigned threads, size_t chunk)
@@ -108,9 +108,27 @@ else:
         print("\u26a0\ufe0f  jh-toolkit not found \u2014 using internal POD fallback")
         extra_compile_args += ["-std=c++17"]
     extra_compile_args.append("-DNPY_NO_DEPRECATED_API=NPY_1_7_API_VERSION")
+    # solve_batch(threads != 1) runs the native std::thread pool
+    extra_compile_args.append("-pthread")
+    extra_link_args.append("-pthread")
 
 # -----------------------------------------------------------------------------
-# Step 3: Define Cython extension
+# Step 3: Optionally link libsudoklite instead of compiling the solver in
+# -----------------------------------------------------------------------------
+libraries = []
+library_dirs = []
+sudoklite_lib_dir = os.environ.get("SUDOKLITE_LIBRARY_DIR")
+if sudoklite_lib_dir:
+    sudoklite_lib_dir = os.path.abspath(sudoklite_lib_dir)
+    print(f"\u2139\ufe0f  Linking against libsudoklite in {sudoklite_lib_dir}")
+    libraries.append("sudoklite")
+    library_dirs.append(sudoklite_lib_dir)
+    extra_compile_args.append("/DSUDOKLITE_SHARED" if is_msvc else "-DSUDOKLITE_SHARED")
+    if not is_msvc:
+        extra_link_args.append(f"-Wl,-rpath,{sudoklite_lib_dir}")
+
+# -----------------------------------------------------------------------------
+# Step 4: Define Cython extension
 # -----------------------------------------------------------------------------
 ext_modules = [
     Extension(
@@ -118,13 +136,15 @@ ext_modules = [
         sources=["sd_solver.pyx"],
         language="c++",
         include_dirs=include_dirs,
+        libraries=libraries,
+        library_dirs=library_dirs,
         extra_compile_args=extra_compile_args,
         extra_link_args=extra_link_args,
     )
 ]
 
 # -----------------------------------------------------------------------------
-# Step 4: Build
+# Step 5: Build
 # -----------------------------------------------------------------------------
 setup(
     name="sd_solver",
@@ -0,0 +1,78 @@
+/**
+ * @file sd_solve_c.c
+ * @brief Plain C client of <code>libsudoklite</code>.
+ *
+ * <p>
+ * Usage: <code>sd_solve_c [input|-] [output|-]</code>
+ * </p>
+ * <p>
+ * Reads 81-character puzzle lines (<code>1</code>&ndash;<code>9</code>
+ * for givens, anything else for an empty cell), solves them in batches of
+ * 4096 with <code>sudoku_solve_batch</code> and writes one solution line per
+ * puzzle, or the status message for puzzles that have none. <code>-</code>
+ * (the default) selects stdin / stdout. The kernel the library selected is
+ * reported on <code>stderr</code>.
+ * </p>
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sd_c_api.h"
+
+enum { batch_size = 4096 };
+
+static sudoku_puzzle_t puzzles[batch_size];
+static sd_status_t statuses[batch_size];
+
+static void flush_batch(const size_t count, FILE *out) {
+    sudoku_solve_batch(puzzles, count, statuses);
+    for (size_t i = 0; i < count; ++i) {
+        if (statuses[i] != SD_STATUS_SOLVED) {
+            fprintf(out, "%s\n", sudoku_status_message(statuses[i]));
+            continue;
+        }
+        char line[82];
+        for (int c = 0; c < 81; ++c) line[c] = (char) ('0' + puzzles[i].data[c]);
+        line[81] = '\0';
+        fprintf(out, "%s\n", line);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 3) {
+        fprintf(stderr, "usage: %s [input|-] [output|-]\n", argv[0]);
+        return 2;
+    }
+    FILE *in = argc > 1 && strcmp(argv[1], "-") != 0 ? fopen(argv[1], "r") : stdin;
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    FILE *out = argc > 2 && strcmp(argv[2], "-") != 0 ? fopen(argv[2], "w") : stdout;
+    if (!out) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    char line[256];
+    size_t count = 0, total = 0;
+    while (fgets(line, sizeof line, in)) {
+        if (strcspn(line, "\r\n") < 81) continue;
+        for (int c = 0; c < 81; ++c)
+            puzzles[count].data[c] = (int8_t) (line[c] >= '1' && line[c] <= '9' ? line[c] - '0' : 0);
+        ++total;
+        if (++count == batch_size) {
+            flush_batch(count, out);
+            count = 0;
+        }
+    }
+    flush_batch(count, out);
+    fprintf(stderr, "%zu puzzles, kernel %s\n", total, sudoku_kernel_name());
+    if (in != stdin) fclose(in);
+    if (out != stdout && fclose(out) != 0) {
+        perror(argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file sd_solve_file.cpp
+ * @brief Command-line front end of <code>sd_stream.hpp</code>.
+ *
+ * <p>
+ * Usage: <code>sd_solve_file [-j threads] [-c chunk_mib] [-p] [-P] [input|-] [output|-]</code>
+ * </p>
+ * <p>
+ * Reads 81-character puzzle lines, writes one solution line per puzzle and
+ * prints the totals and throughput to <code>stderr</code>. <code>-j 0</code> uses
+ * every hardware thread; <code>-</code> (the default) selects stdin / stdout.
+ * <code>-p</code> / <code>-P</code> switch the input / output to packed 41-byte records.
+ * </p>
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "sd_stream.hpp"
+
+namespace {
+    int usage(const char *program) {
+        std::fprintf(stderr, "usage: %s [-j threads] [-c chunk_mib] [-p] [-P] [input|-] [output|-]\n", program);
+        return 2;
+    }
+}
+
+int main(int argc, char **argv) {
+    sd::StreamOptions options{};
+    const char *paths[2] = {"-", "-"};
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if ((std::strcmp(arg, "-j") == 0 || std::strcmp(arg, "-c") == 0) && i + 1 < argc) {
+            const unsigned long value = std::strtoul(argv[++i], nullptr, 10);
+            if (arg[1] == 'j') options.threads = static_cast<unsigned>(value);
+            else options.chunk_bytes = static_cast<std::size_t>(value ? value : 1) << 20;
+        } else if (std::strcmp(arg, "-p") == 0) {
+            options.input = sd::StreamFormat::packed;
+        } else if (std::strcmp(arg, "-P") == 0) {
+            options.output = sd::StreamFormat::packed;
+        } else if (arg[0] != '-' || arg[1] == '\0') {
+            if (positional == 2) return usage(argv[0]);
+            paths[positional++] = arg;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    std::FILE *in = std::strcmp(paths[0], "-") == 0 ? stdin : std::fopen(paths[0], "rb");
+    if (!in) {
+        std::perror(paths[0]);
+        return 1;
+    }
+    std::FILE *out = std::strcmp(paths[1], "-") == 0 ? stdout : std::fopen(paths[1], "wb");
+    if (!out) {
+        std::perror(paths[1]);
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const sd::StreamStats stats = sd::solve_stream(in, out, options);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (in != stdin) std::fclose(in);
+    const bool write_failed = std::fflush(out) != 0 || (out != stdout && std::fclose(out) != 0);
+
+    std::fprintf(stderr, "%llu puzzles: %llu solved, %llu invalid, %llu unsolvable, %llu lines skipped\n",
+                 static_cast<unsigned long long>(stats.puzzles), static_cast<unsigned long long>(stats.solved),
+                 static_cast<unsigned long long>(stats.invalid), static_cast<unsigned long long>(stats.unsolvable),
+                 static_cast<unsigned long long>(stats.skipped_lines));
+    std::fprintf(stderr, "%.3f s, %.0f puzzles/s\n", seconds,
+                 seconds > 0 ? static_cast<double>(stats.puzzles) / seconds : 0.0);
+    if (stats.io_error || write_failed) {
+        std::fprintf(stderr, "I/O error\n");
+        return 1;
+    }
+    return 0;
+}
@@ -4,8 +4,46 @@
 #include <stdint.h>
 #include <stddef.h>
 
-#ifdef __cplusplus
+/**
+ * <h3>Linkage</h3>
+ *
+ * <p><b>Description:</b><br/>
+ * Included from C++, this header is the whole solver: every function below is
+ * <code>static inline</code> and compiled into the including translation unit.
+ * Included from C, or from C++ with <code>SUDOKLITE_SHARED</code> defined, it
+ * only declares the functions, which then resolve against the shared library
+ * <code>libsudoklite</code>. Its CMake target <code>sudoklite::shared</code>
+ * defines <code>SUDOKLITE_SHARED</code> for its users.</p>
+ *
+ * <p>The library exports exactly these functions, under the ELF symbol version
+ * <code>SUDOKLITE_1</code> where the linker supports it, and picks the
+ * fastest kernel the CPU supports on first use (see
+ * <code>sudoku_kernel_name</code>).</p>
+ */
+#if defined(SUDOKLITE_BUILDING_LIBRARY)
+#  define SD_C_API_INLINE 0
+#  if defined(_WIN32)
+#    define SD_C_API __declspec(dllexport)
+#  else
+#    define SD_C_API __attribute__((visibility("default")))
+#  endif
+#elif defined(SUDOKLITE_SHARED) || !defined(__cplusplus)
+#  define SD_C_API_INLINE 0
+#  if defined(_WIN32)
+#    define SD_C_API __declspec(dllimport)
+#  else
+#    define SD_C_API
+#  endif
+#else
+#  define SD_C_API_INLINE 1
+#  define SD_C_API static inline
+#endif
+
+#if SD_C_API_INLINE
 #include "sudok_solver.hpp"
+#endif
+
+#ifdef __cplusplus
 extern "C" {
 #endif
 
@@ -49,6 +87,119 @@ extern "C" {
         int8_t data[81];
     } sudoku_puzzle_t;
 
+    /**
+     * <h3>Enumeration: sd_status_t</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Numeric per-puzzle outcome reported by <code>sudoku_solve_c</code> and the
+     * batch API. The values are
+     * identical to <code>sd::Status</code> on the C++ side, so callers can
+     * branch on an integer instead of comparing strings.</p>
+     *
+     * <ul>
+     *   <li><b><code>SD_STATUS_SOLVED</code></b> &nbsp;&mdash;&nbsp;
+     *       the solution was written back to the puzzle.</li>
+     *   <li><b><code>SD_STATUS_INVALID_SIZE</code></b> &nbsp;&mdash;&nbsp;
+     *       the buffer does not describe a 9×9 grid.</li>
+     *   <li><b><code>SD_STATUS_INVALID_PUZZLE</code></b> &nbsp;&mdash;&nbsp;
+     *       the givens repeat a digit in a row, column, or 3×3 box.</li>
+     *   <li><b><code>SD_STATUS_UNSOLVABLE</code></b> &nbsp;&mdash;&nbsp;
+     *       the givens are consistent but admit no solution.</li>
+     *   <li><b><code>SD_STATUS_LIMIT_REACHED</code></b> &nbsp;&mdash;&nbsp;
+     *       the search was stopped by a budget or cancellation before finishing.</li>
+     * </ul>
+     */
+    typedef enum {
+        SD_STATUS_SOLVED = 0,
+        SD_STATUS_INVALID_SIZE = 1,
+        SD_STATUS_INVALID_PUZZLE = 2,
+        SD_STATUS_UNSOLVABLE = 3,
+        SD_STATUS_LIMIT_REACHED = 4
+    } sd_status_t;
+
+    /**
+     * <h3>Function: sudoku_solve_c</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Numeric counterpart of <code>sudoku_solver_c</code>: solves the puzzle in
+     * place and reports the outcome as an <code>sd_status_t</code>, so callers
+     * branch on an integer instead of comparing strings.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * <code>SD_STATUS_SOLVED</code> with the solution written to
+     * <code>puzzle-&gt;data</code>, otherwise the failure reason.
+     * A <code>NULL</code> puzzle yields <code>SD_STATUS_INVALID_SIZE</code>.</p>
+     */
+    SD_C_API sd_status_t sudoku_solve_c(sudoku_puzzle_t *puzzle);
+
+    /**
+     * <h3>Structure: sudoku_stats_t</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Counters of one search, filled by <code>sudoku_solve_stats</code>. The
+     * fields mirror <code>sd::SolveStats</code>.</p>
+     *
+     * <ul>
+     *   <li><b><code>guesses</code></b> &nbsp;&mdash;&nbsp; alternatives tried by the search.</li>
+     *   <li><b><code>backtracks</code></b> &nbsp;&mdash;&nbsp; branch points abandoned after their last alternative.</li>
+     *   <li><b><code>contradictions</code></b> &nbsp;&mdash;&nbsp; propagations that ended in a contradiction.</li>
+     *   <li><b><code>propagations</code></b> &nbsp;&mdash;&nbsp; deduction passes (the root plus one per guess).</li>
+     *   <li><b><code>solutions</code></b> &nbsp;&mdash;&nbsp; solutions reached.</li>
+     *   <li><b><code>max_depth</code></b> &nbsp;&mdash;&nbsp; deepest branch-point stack.</li>
+     *   <li><b><code>deduce_cycles</code></b>, <b><code>branch_cycles</code></b> &nbsp;&mdash;&nbsp;
+     *       ticks spent in deduction and branch selection; 0 unless the header was
+     *       compiled with <code>SD_ENABLE_CYCLE_TIMERS=1</code>.</li>
+     * </ul>
+     */
+    typedef struct {
+        uint64_t guesses;
+        uint64_t backtracks;
+        uint64_t contradictions;
+        uint64_t propagations;
+        uint64_t solutions;
+        uint64_t max_depth;
+        uint64_t deduce_cycles;
+        uint64_t branch_cycles;
+    } sudoku_stats_t;
+
+    /**
+     * <h3>Function: sudoku_solve_stats</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Same contract as <code>sudoku_solve_c</code>, additionally reporting the
+     * search counters in <code>stats</code> (which may be <code>NULL</code>).
+     * The counters are all zero when the givens are rejected before the search.</p>
+     */
+    SD_C_API sd_status_t sudoku_solve_stats(sudoku_puzzle_t *puzzle, sudoku_stats_t *stats);
+
+    /**
+     * <h3>Function: sudoku_solve_limited</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Same contract as <code>sudoku_solve_c</code>, but the search gives up once
+     * it has tried <code>max_nodes</code> guesses or run for
+     * <code>timeout_us</code> microseconds, so a worker's time per puzzle is
+     * bounded. Both limits are checked every 64 guesses; <code>0</code>
+     * disables a limit.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * <code>SD_STATUS_LIMIT_REACHED</code> with <code>puzzle</code> unchanged if a
+     * limit stopped the search, otherwise as <code>sudoku_solve_c</code>.</p>
+     */
+    SD_C_API sd_status_t sudoku_solve_limited(sudoku_puzzle_t *puzzle, uint64_t max_nodes, uint64_t timeout_us);
+
+    /**
+     * <h3>Function: sudoku_status_message</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * The message <code>sudoku_solver_c</code> returns for a status, for logging
+     * and error reporting off the hot path.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * A static null-terminated string owned by the library.</p>
+     */
+    SD_C_API const char *sudoku_status_message(sd_status_t status);
+
     /**
      * <h3>Function: sudoku_solver_c</h3>
      *
@@ -89,7 +240,8 @@ extern "C" {
      *
      * <p><b>Return value:</b><br/>
      * A constant null-terminated string describing the solver outcome.
-     * The returned pointer is owned by the library and must not be freed.</p>
+     * The returned pointer is owned by the library and must not be freed.
+     * Prefer <code>sudoku_solve_c</code> when the outcome is only branched on.</p>
      *
      * <p><b>Thread-safety:</b><br/>
      * This function is <i>thread-safe</i> as long as different threads
@@ -101,13 +253,505 @@ extern "C" {
      * This ensures safe interoperability between the C++ core and
      * C-based foreign-function interfaces (FFI) without compromising memory safety.</p>
      */
-    static inline const char *sudoku_solver_c(sudoku_puzzle_t* puzzle){
+    SD_C_API const char *sudoku_solver_c(sudoku_puzzle_t* puzzle);
+
+    /**
+     * <h3>Function: sudoku_solve_batch</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Solve a contiguous array of <code>sudoku_puzzle_t</code> in place with a
+     * single call, amortizing the FFI and dispatch cost over the whole batch.
+     * All puzzles share one solver workspace (the calling thread's), so the
+     * batch performs no heap allocation.</p>
+     *
+     * <p><b>Parameters:</b></p>
+     * <ul>
+     *   <li><b><code>puzzles</code></b> &nbsp;&mdash;&nbsp;
+     *       Pointer to <code>n</code> consecutive puzzles.</li>
+     *   <li><b><code>n</code></b> &nbsp;&mdash;&nbsp;
+     *       Number of puzzles.</li>
+     *   <li><b><code>out_status</code></b> &nbsp;&mdash;&nbsp;
+     *       Optional array of <code>n</code> entries receiving each puzzle's
+     *       <code>sd_status_t</code>; may be <code>NULL</code>.</li>
+     * </ul>
+     *
+     * <p><b>Return value:</b><br/>
+     * The number of puzzles solved. If <code>puzzles</code> is <code>NULL</code>,
+     * nothing is written and 0 is returned.</p>
+     *
+     * <p><b>Thread-safety:</b><br/>
+     * Concurrent calls are safe as long as they operate on distinct buffers.</p>
+     */
+    SD_C_API size_t sudoku_solve_batch(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status);
+
+    /**
+     * <h3>Function: sudoku_count_solutions</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Count the solutions of a puzzle without modifying it, stopping as soon as
+     * <code>limit</code> solutions have been found. This is the uniqueness check
+     * of puzzle generation and runs on the same engine as the solver.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * The number of solutions found, at most <code>limit</code>. Returns 0 if
+     * <code>puzzle</code> is <code>NULL</code> or its givens contradict each other.</p>
+     */
+    SD_C_API uint32_t sudoku_count_solutions(const sudoku_puzzle_t *puzzle, uint32_t limit);
+
+    /**
+     * <h3>Function: sudoku_has_unique_solution</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Shortcut for <code>sudoku_count_solutions(puzzle, 2) == 1</code>.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * 1 if the puzzle has exactly one solution, 0 otherwise.</p>
+     */
+    SD_C_API int sudoku_has_unique_solution(const sudoku_puzzle_t *puzzle);
+
+    /**
+     * <h3>Enumerations: sd_verdict_t, sd_difficulty_t</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Outcome and difficulty reported by <code>sudoku_triage</code>, with the
+     * values of <code>sd::Verdict</code> and <code>sd::Difficulty</code>.</p>
+     *
+     * <ul>
+     *   <li><b><code>SD_VERDICT_OPEN</code></b> &nbsp;&mdash;&nbsp; consistent so far; only a search can tell more.</li>
+     *   <li><b><code>SD_VERDICT_UNIQUE</code></b> &nbsp;&mdash;&nbsp; deduction alone completes it.</li>
+     *   <li><b><code>SD_VERDICT_AMBIGUOUS</code></b> &nbsp;&mdash;&nbsp;
+     *       fewer than 17 clues or 8 distinct digits, so it cannot have a unique solution.</li>
+     *   <li><b><code>SD_VERDICT_INVALID</code></b> &nbsp;&mdash;&nbsp; the givens repeat a digit in a unit.</li>
+     *   <li><b><code>SD_VERDICT_UNSOLVABLE</code></b> &nbsp;&mdash;&nbsp; deduction reaches a contradiction.</li>
+     *   <li><b><code>SD_DIFFICULTY_*</code></b> &nbsp;&mdash;&nbsp; weakest deduction level that completes
+     *       the puzzle, or <code>SD_DIFFICULTY_SEARCH</code> if guessing is required.</li>
+     * </ul>
+     */
+    typedef enum {
+        SD_VERDICT_OPEN = 0,
+        SD_VERDICT_UNIQUE = 1,
+        SD_VERDICT_AMBIGUOUS = 2,
+        SD_VERDICT_INVALID = 3,
+        SD_VERDICT_UNSOLVABLE = 4
+    } sd_verdict_t;
+
+    typedef enum {
+        SD_DIFFICULTY_NAKED_SINGLES = 0,
+        SD_DIFFICULTY_HIDDEN_SINGLES = 1,
+        SD_DIFFICULTY_PAIRS = 2,
+        SD_DIFFICULTY_SEARCH = 3
+    } sd_difficulty_t;
+
+    /**
+     * <h3>Structure: sudoku_triage_t</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Result of <code>sudoku_triage</code>, laid out as <code>sd::Triage</code>:
+     * <code>verdict</code> (<code>sd_verdict_t</code>), <code>difficulty</code>
+     * (<code>sd_difficulty_t</code>), the number of <code>clues</code>, the
+     * distinct <code>digits</code> among them and the <code>open_cells</code>
+     * deduction left undecided.</p>
+     */
+    typedef struct {
+        uint8_t verdict;
+        uint8_t difficulty;
+        uint16_t clues;
+        uint8_t digits;
+        uint16_t open_cells;
+    } sudoku_triage_t;
+
+    /**
+     * <h3>Function: sudoku_triage</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Classify a puzzle without searching: reject contradictory givens, flag
+     * puzzles that cannot be unique and grade the rest by the deduction level
+     * that completes them. Costs about one propagation pass, so easy and hard
+     * puzzles can be routed to different workers before any search runs. The
+     * puzzle is not modified; <code>out</code> may be <code>NULL</code>.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * The verdict; <code>SD_VERDICT_INVALID</code> for a <code>NULL</code> puzzle.</p>
+     */
+    SD_C_API sd_verdict_t sudoku_triage(const sudoku_puzzle_t *puzzle, sudoku_triage_t *out);
+
+    /**
+     * <h3>Structures: sudoku_candidates_t, sudoku_candidate_update_t</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * <code>sudoku_candidates_t</code> is a live pencil-mark grid with the
+     * layout of <code>sd::CandidateGrid</code>. Each <code>cells</code> entry has
+     * bit 0 set for a placed digit and bits 1&ndash;9 for the digit or the
+     * remaining candidates. It is plain data: keep it in caller memory and edit
+     * it with <code>sudoku_candidates_place</code>.</p>
+     *
+     * <p><code>sudoku_candidate_update_t</code> lists the <code>count</code>
+     * cells an edit changed (the edited cell first) with their new candidate
+     * masks (bits 1&ndash;9), and whether the edit left them
+     * <code>consistent</code>.</p>
+     */
+    typedef struct {
+        uint16_t cells[81];
+    } sudoku_candidates_t;
+
+    typedef struct {
+        uint8_t consistent;
+        uint8_t count;
+        uint8_t cells[21];
+        uint16_t masks[21];
+    } sudoku_candidate_update_t;
+
+    /**
+     * <h3>Function: sudoku_candidates_init</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Start a grid from the givens of <code>puzzle</code>; <code>NULL</code>
+     * starts an empty grid. Empty cells get every digit no peer holds.</p>
+     */
+    SD_C_API void sudoku_candidates_init(sudoku_candidates_t *grid, const sudoku_puzzle_t *puzzle);
+
+    /**
+     * <h3>Function: sudoku_candidates_place</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Put <code>digit</code> in cell <code>cell</code> (0&ndash;80, row-major),
+     * or clear the cell if <code>digit</code> is 0, and update the candidates of
+     * its peers by elimination alone. The changed cells are reported in
+     * <code>update</code>, which may be <code>NULL</code>.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * 1 if the edit left the touched cells consistent, 0 if the digit repeats in
+     * a unit or a cell ran out of candidates, -1 for a <code>NULL</code> grid,
+     * a cell index above 80 or a digit above 9 (the grid is then untouched).</p>
+     */
+    SD_C_API int sudoku_candidates_place(sudoku_candidates_t *grid, uint8_t cell, uint8_t digit,
+                                         sudoku_candidate_update_t *update);
+
+    /**
+     * <h3>Function: sudoku_generate</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Generate a puzzle with a unique solution from a random complete grid,
+     * removing clues while the solution stays unique. The same <code>seed</code>
+     * always yields the same puzzle. No heap allocation is performed.</p>
+     *
+     * <p><b>Parameters:</b></p>
+     * <ul>
+     *   <li><b><code>puzzle</code></b> &nbsp;&mdash;&nbsp;
+     *       Receives the puzzle, 0 for empty cells.</li>
+     *   <li><b><code>solution</code></b> &nbsp;&mdash;&nbsp;
+     *       Optional; receives the unique solution. May be <code>NULL</code>.</li>
+     *   <li><b><code>target_clues</code></b> &nbsp;&mdash;&nbsp;
+     *       Stop removing clues at this count; <code>0</code> reduces the puzzle
+     *       until no clue can be removed.</li>
+     *   <li><b><code>min_guesses</code></b> &nbsp;&mdash;&nbsp;
+     *       Difficulty floor: reject puzzles the solver finishes in fewer search
+     *       nodes; <code>0</code> accepts any puzzle.</li>
+     * </ul>
+     *
+     * <p><b>Return value:</b><br/>
+     * The number of clues of the generated puzzle, or 0 if <code>puzzle</code>
+     * is <code>NULL</code> or no attempt met <code>min_guesses</code>.</p>
+     */
+    SD_C_API uint32_t sudoku_generate(sudoku_puzzle_t *puzzle, sudoku_puzzle_t *solution, uint64_t seed,
+                                      uint32_t target_clues, uint32_t min_guesses);
+
+    /**
+     * <h3>Structure: sudoku_packed_t</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Compact storage form of a puzzle: 81 cells at 4 bits each, 41 bytes.
+     * Cell <code>i</code> is held in byte <code>i / 2</code>, even cells in the
+     * low nibble and odd cells in the high nibble; 0 is an empty cell and
+     * 1&nbsp;&ndash;&nbsp;9 a digit. Intended for archives and bulk I/O, where it
+     * halves the footprint of <code>sudoku_puzzle_t</code>.</p>
+     */
+    typedef struct {
+        uint8_t data[41];
+    } sudoku_packed_t;
+
+    /**
+     * <h3>Function: sudoku_pack</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Encode <code>puzzle</code> into <code>packed</code>; values outside
+     * 1&nbsp;&ndash;&nbsp;9 are stored as empty cells.</p>
+     */
+    SD_C_API void sudoku_pack(const sudoku_puzzle_t *puzzle, sudoku_packed_t *packed);
+
+    /**
+     * <h3>Function: sudoku_unpack</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Decode <code>packed</code> into <code>puzzle</code>; nibbles above 9 are
+     * decoded as empty cells.</p>
+     */
+    SD_C_API void sudoku_unpack(const sudoku_packed_t *packed, sudoku_puzzle_t *puzzle);
+
+    /**
+     * <h3>Function: sudoku_solve_batch_packed</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Same contract as <code>sudoku_solve_batch</code> on packed records: each
+     * record is decoded directly into the solver's cell masks and, once solved,
+     * re-encoded in place. A nibble above 9 is reported as
+     * <code>SD_STATUS_INVALID_PUZZLE</code>.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * The number of puzzles solved; 0 if <code>puzzles</code> is <code>NULL</code>.</p>
+     */
+    SD_C_API size_t sudoku_solve_batch_packed(sudoku_packed_t *puzzles, size_t n, sd_status_t *out_status);
+
+#if !SD_C_API_INLINE || SD_ENABLE_THREADS
+    /**
+     * <h3>Function: sudoku_solve_batch_parallel</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Same contract as <code>sudoku_solve_batch</code>, but the batch is spread
+     * over several worker threads. Workers claim <code>chunk</code> puzzles at a
+     * time from a shared counter, so uneven puzzle difficulty does not leave
+     * cores idle. Each worker owns its solver workspace. The shared library
+     * always exports it; built without thread support, it runs the batch on
+     * the calling thread.</p>
+     *
+     * <p><b>Parameters:</b></p>
+     * <ul>
+     *   <li><b><code>threads</code></b> &nbsp;&mdash;&nbsp;
+     *       Worker count, including the calling thread; <code>0</code> selects the
+     *       number of hardware threads.</li>
+     *   <li><b><code>chunk</code></b> &nbsp;&mdash;&nbsp;
+     *       Puzzles claimed per scheduling step; <code>0</code> is treated as 1.
+     *       Small chunks balance better, large chunks reduce contention.</li>
+     * </ul>
+     *
+     * <p><b>Return value:</b><br/>
+     * The number of puzzles solved; 0 if <code>puzzles</code> is <code>NULL</code>.</p>
+     */
+    SD_C_API size_t sudoku_solve_batch_parallel(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status,
+                                                unsigned threads, size_t chunk);
+#endif
+
+    /**
+     * <h3>Function: sudoku_kernel_name</h3>
+     *
+     * <p><b>Description:</b><br/>
+     * Instruction set the solver runs on: <code>"avx512"</code>,
+     * <code>"avx2"</code>, <code>"sse2"</code>, <code>"neon"</code> or
+     * <code>"scalar"</code>. The header-only build reports the target it was
+     * compiled for. The shared library holds one kernel per x86-64 level and, on
+     * the first call into it, selects the best one the CPU and OS support. The
+     * environment variable <code>SUDOKLITE_KERNEL</code> may name a kernel to
+     * use instead (useful for A/B runs), and is ignored if the CPU cannot run it.</p>
+     *
+     * <p><b>Return value:</b><br/>
+     * A static null-terminated string owned by the library.</p>
+     */
+    SD_C_API const char *sudoku_kernel_name(void);
+
+#if SD_C_API_INLINE
+    // =========================
+    //   HEADER-ONLY DEFINITIONS
+    // =========================
+
+    static inline sd_status_t sudoku_solve_c(sudoku_puzzle_t *puzzle) {
+        if (!puzzle) return SD_STATUS_INVALID_SIZE;
+        return static_cast<sd_status_t>(sd::sudoku_solve(puzzle->data, sizeof(puzzle->data) / sizeof(puzzle->data[0])));
+    }
+
+    static inline sd_status_t sudoku_solve_stats(sudoku_puzzle_t *puzzle, sudoku_stats_t *stats) {
+        if (!puzzle) return SD_STATUS_INVALID_SIZE;
+        if (!stats) return sudoku_solve_c(puzzle);
+        sd::SolveStats s{};
+        const sd::Status status = sd::solve_puzzle(puzzle->data, sd::detail::default_workspace(), sd::SolveOptions{}, s);
+        stats->guesses = s.guesses;
+        stats->backtracks = s.backtracks;
+        stats->contradictions = s.contradictions;
+        stats->propagations = s.propagations;
+        stats->solutions = s.solutions;
+        stats->max_depth = s.max_depth;
+        stats->deduce_cycles = s.deduce_cycles;
+        stats->branch_cycles = s.branch_cycles;
+        return static_cast<sd_status_t>(status);
+    }
+
+    static inline sd_status_t sudoku_solve_limited(sudoku_puzzle_t *puzzle, uint64_t max_nodes, uint64_t timeout_us) {
+        if (!puzzle) return SD_STATUS_INVALID_SIZE;
+        sd::SolveLimits limits = timeout_us ? sd::SolveLimits::within(std::chrono::microseconds(timeout_us))
+                                            : sd::SolveLimits{};
+        limits.max_nodes = max_nodes;
+        return static_cast<sd_status_t>(sd::solve_puzzle(puzzle->data, sd::detail::default_workspace(),
+                                                         sd::SolveOptions{}, limits));
+    }
+
+    static inline const char *sudoku_status_message(sd_status_t status) {
+        return sd::status_message(static_cast<sd::Status>(status));
+    }
+
+    static inline const char *sudoku_solver_c(sudoku_puzzle_t* puzzle) {
         if (!puzzle) return "Null pointer";
-        return sd::sudoku_solver(puzzle->data, sizeof(puzzle->data)/sizeof(puzzle->data[0]));
+        return sudoku_status_message(sudoku_solve_c(puzzle));
     }
 
+    static inline size_t sudoku_solve_batch(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status) {
+        if (!puzzles) return 0;
+        sd::SolverWorkspace &workspace = sd::detail::default_workspace();
+        size_t solved = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const sd::Status status = sd::solve_puzzle(puzzles[i].data, workspace);
+            solved += status == sd::Status::solved;
+            if (out_status) out_status[i] = static_cast<sd_status_t>(status);
+        }
+        return solved;
+    }
+
+    static inline uint32_t sudoku_count_solutions(const sudoku_puzzle_t *puzzle, uint32_t limit) {
+        if (!puzzle) return 0;
+        sd::Board board{};
+        board.load_int8_t(puzzle->data);
+        if (!board.check_initial_valid()) return 0;
+        return sd::count_solutions(board, limit);
+    }
+
+    static inline int sudoku_has_unique_solution(const sudoku_puzzle_t *puzzle) {
+        return sudoku_count_solutions(puzzle, 2) == 1;
+    }
+
+    static inline sd_verdict_t sudoku_triage(const sudoku_puzzle_t *puzzle, sudoku_triage_t *out) {
+        if (!puzzle) return SD_VERDICT_INVALID;
+        sd::Board board{};
+        board.load_int8_t(puzzle->data);
+        const sd::Triage t = sd::triage(board);
+        if (out) {
+            out->verdict = static_cast<uint8_t>(t.verdict);
+            out->difficulty = static_cast<uint8_t>(t.difficulty);
+            out->clues = t.clues;
+            out->digits = t.digits;
+            out->open_cells = t.open_cells;
+        }
+        return static_cast<sd_verdict_t>(t.verdict);
+    }
+
+    static inline void sudoku_candidates_init(sudoku_candidates_t *grid, const sudoku_puzzle_t *puzzle) {
+        if (!grid) return;
+        sd::CandidateGrid live{};
+        if (puzzle) {
+            sd::Board board{};
+            board.load_int8_t(puzzle->data);
+            live = sd::CandidateGrid(board);
+        }
+        std::memcpy(grid, &live, sizeof(live));
+    }
+
+    static inline int sudoku_candidates_place(sudoku_candidates_t *grid, uint8_t cell, uint8_t digit,
+                                              sudoku_candidate_update_t *update) {
+        if (!grid || cell >= 81 || digit > 9) return -1;
+        sd::CandidateGrid live;
+        std::memcpy(static_cast<void *>(&live), grid, sizeof(live));
+        const sd::CandidateGrid::Update u = live.place(cell, digit);
+        std::memcpy(grid, &live, sizeof(live));
+        if (update) {
+            update->consistent = u.consistent;
+            update->count = u.count;
+            for (uint8_t i = 0; i < u.count; ++i) {
+                update->cells[i] = u.changes[i].cell;
+                update->masks[i] = u.changes[i].mask;
+            }
+        }
+        return u.consistent;
+    }
+
+    static inline uint32_t sudoku_generate(sudoku_puzzle_t *puzzle, sudoku_puzzle_t *solution, uint64_t seed,
+                                           uint32_t target_clues, uint32_t min_guesses) {
+        if (!puzzle) return 0;
+        sd::GenerateOptions options{};
+        options.seed = seed;
+        options.target_clues = static_cast<uint8_t>(target_clues > 81 ? 81 : target_clues);
+        options.min_guesses = min_guesses;
+        sd::Board board{}, grid{};
+        const uint8_t clues = sd::generate(board, options, sd::detail::default_workspace(), &grid);
+        if (!clues) return 0;
+        for (uint8_t i = 0; i < 81; ++i) {
+            puzzle->data[i] = board.cells[i].getConfirmedValue();
+            if (solution) solution->data[i] = grid.cells[i].getConfirmedValue();
+        }
+        return clues;
+    }
+
+    static inline void sudoku_pack(const sudoku_puzzle_t *puzzle, sudoku_packed_t *packed) {
+        if (!puzzle || !packed) return;
+        sd::pack_int8_t(puzzle->data, packed->data);
+    }
+
+    static inline void sudoku_unpack(const sudoku_packed_t *packed, sudoku_puzzle_t *puzzle) {
+        if (!puzzle || !packed) return;
+        sd::unpack_int8_t(packed->data, puzzle->data);
+    }
+
+    static inline size_t sudoku_solve_batch_packed(sudoku_packed_t *puzzles, size_t n, sd_status_t *out_status) {
+        if (!puzzles) return 0;
+        sd::SolverWorkspace &workspace = sd::detail::default_workspace();
+        size_t solved = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const sd::Status status = sd::solve_packed(puzzles[i].data, workspace);
+            solved += status == sd::Status::solved;
+            if (out_status) out_status[i] = static_cast<sd_status_t>(status);
+        }
+        return solved;
+    }
+
+#if SD_ENABLE_THREADS
+    static inline size_t sudoku_solve_batch_parallel(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status,
+                                                     unsigned threads, size_t chunk) {
+        if (!puzzles) return 0;
+        sd::ParallelOptions options{};
+        options.threads = threads;
+        options.chunk = chunk;
+        std::atomic<size_t> solved{0};
+        sd::detail::parallel_chunks(n, options, [&](const size_t begin, const size_t end,
+                                                    sd::SolverWorkspace &workspace) {
+            size_t local = 0;
+            for (size_t i = begin; i < end; ++i) {
+                const sd::Status status = sd::solve_puzzle(puzzles[i].data, workspace);
+                local += status == sd::Status::solved;
+                if (out_status) out_status[i] = static_cast<sd_status_t>(status);
+            }
+            solved.fetch_add(local, std::memory_order_relaxed);
+        });
+        return solved.load();
+    }
+#endif
+
+    static inline const char *sudoku_kernel_name(void) {
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+        return "avx512";
+#elif defined(__AVX2__)
+        return "avx2";
+#elif SD_SIMD == SD_SIMD_SSE2
+        return "sse2";
+#elif SD_SIMD == SD_SIMD_NEON
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+#endif
+
 #ifdef __cplusplus
 }
 #endif
 
+#if SD_C_API_INLINE
+static_assert(sizeof(sudoku_puzzle_t) == 81, "sudoku_puzzle_t must be a packed 81-cell buffer");
+static_assert(sizeof(sudoku_packed_t) == sd::packed_size, "sudoku_packed_t must match sd::packed_size");
+static_assert(sizeof(sudoku_stats_t) == sizeof(sd::SolveStats), "sudoku_stats_t must mirror sd::SolveStats");
+static_assert(sizeof(sudoku_candidates_t) == sizeof(sd::CandidateGrid), "sudoku_candidates_t must mirror sd::CandidateGrid");
+static_assert(sd::CandidateGrid::max_changes == 21, "sudoku_candidate_update_t holds 21 changes");
+static_assert(sizeof(sudoku_triage_t) == sizeof(sd::Triage), "sudoku_triage_t must mirror sd::Triage");
+static_assert(static_cast<int>(SD_VERDICT_UNSOLVABLE) == static_cast<int>(sd::Verdict::unsolvable) &&
+              static_cast<int>(SD_DIFFICULTY_SEARCH) == static_cast<int>(sd::Difficulty::search),
+              "sd_verdict_t and sd_difficulty_t must mirror sd::Verdict and sd::Difficulty");
+static_assert(static_cast<int>(SD_STATUS_LIMIT_REACHED) == static_cast<int>(sd::Status::limit_reached),
+              "sd_status_t must mirror sd::Status");
+#endif
+
 #endif // SD_C_API_H
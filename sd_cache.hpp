@@ -0,0 +1,499 @@
+/**
+ * @file sd_cache.hpp
+ * @author JeongHan-Bae
+ * @email &lt;mastropseudo&#64;gmail.com&gt;
+ * @brief Canonical forms of 9x9 puzzles and a solution cache keyed by them
+ *
+ * <h3>Description</h3>
+ * <p>
+ * Two puzzles are <i>isomorphic</i> if one turns into the other by relabelling
+ * digits, permuting rows within a band or columns within a stack, permuting the
+ * bands or the stacks, or transposing. Isomorphic puzzles have isomorphic
+ * solutions, so one search serves the whole class.
+ * </p>
+ * <p>
+ * <code>canonicalize()</code> maps a puzzle to the lexicographically smallest
+ * member of its class (its <i>minlex</i> form, cells in row-major order with
+ * digits relabelled in order of first appearance) and returns the
+ * <code>Transform</code> that produced it. <code>SolutionCache</code> sits in
+ * front of <code>solve()</code>: an exact repeat costs one hash lookup, an
+ * isomorphic puzzle a canonicalization and a second lookup.
+ * </p>
+ *
+ * <h3>Cost</h3>
+ * <p>
+ * The minlex search keeps every partial transform that ties on the rows fixed
+ * so far. Typical puzzles keep a few hundred after the first row and a handful
+ * after the third, and canonicalize in 10–40 microseconds: cheaper than a hard
+ * search, dearer than an easy one. Very sparse or highly symmetric grids can
+ * tie on thousands. Past
+ * <code>canonical_candidate_limit</code> ties the search finishes greedily from
+ * one of them and marks the result inexact: still a valid image of the puzzle,
+ * but isomorphic copies may map to a different one and miss the cache.
+ * </p>
+ *
+ * <h3>License</h3>
+ * <p>
+ * <b>MIT License</b><br/>
+ * Copyright (c) 2025 JeongHan-Bae
+ * </p>
+ */
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "sudok_solver.hpp"
+
+#if SD_ENABLE_THREADS
+#include <mutex>
+#endif
+
+SD_BEGIN_NAMESPACE
+    // =========================
+    //   SYMMETRY
+    // =========================
+
+    /**
+     * @brief One element of the 9x9 symmetry group: a relabelling, a transposition and line permutations.
+     *
+     * <p>
+     * Cell <code>(i, j)</code> of the result is
+     * <code>digits[source(rows[i], cols[j])]</code>, where <code>source</code> is
+     * the puzzle, transposed first if <code>transpose</code> is set.
+     * </p>
+     */
+    struct Transform {
+        bool transpose;     ///< Read the source transposed
+        uint8_t rows[9];    ///< Row <code>i</code> of the image is source row <code>rows[i]</code>
+        uint8_t cols[9];    ///< Column <code>j</code> of the image is source column <code>cols[j]</code>
+        uint8_t digits[10]; ///< Source digit <code>d</code> becomes <code>digits[d]</code>; <code>digits[0] = 0</code>
+
+        /// Image of an 81-cell source grid (<code>image</code> must not alias <code>source</code>)
+        void apply(const int8_t *source, int8_t *image) const noexcept {
+            for (uint8_t i = 0; i < 9; ++i)
+                for (uint8_t j = 0; j < 9; ++j)
+                    image[i * 9 + j] = static_cast<int8_t>(digits[static_cast<uint8_t>(source[index(i, j)])]);
+        }
+
+        /// Inverse of <code>apply()</code>: the source grid of an image (the buffers must not alias)
+        void restore(const int8_t *image, int8_t *source) const noexcept {
+            uint8_t inverse[10] = {};
+            for (uint8_t d = 0; d < 10; ++d) inverse[digits[d]] = d;
+            for (uint8_t i = 0; i < 9; ++i)
+                for (uint8_t j = 0; j < 9; ++j)
+                    source[index(i, j)] = static_cast<int8_t>(inverse[static_cast<uint8_t>(image[i * 9 + j])]);
+        }
+
+    private:
+        [[nodiscard]] uint8_t index(const uint8_t i, const uint8_t j) const noexcept {
+            return static_cast<uint8_t>(transpose ? cols[j] * 9 + rows[i] : rows[i] * 9 + cols[j]);
+        }
+    };
+
+    /**
+     * @brief A puzzle's canonical form and the transform that produces it.
+     */
+    struct Canonical {
+        int8_t grid[81];     ///< Minlex form, 0 for empty cells
+        Transform transform; ///< Maps the puzzle onto <code>grid</code>
+        bool exact;          ///< false if the tie limit cut the search short
+    };
+
+    namespace detail {
+        /**
+         * @brief Partial transforms kept per row of the minlex search before it gives up on exactness.
+         */
+        inline constexpr std::size_t canonical_candidate_limit = 4096;
+
+        /// The six orders of three lines
+        inline constexpr uint8_t triple_orders[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+        /**
+         * @brief A transform whose first rows are fixed; columns and labels fixed so far included.
+         */
+        struct CanonicalCandidate {
+            uint8_t rows[9];
+            uint8_t cols[9];
+            uint8_t digits[10];
+            uint8_t next_label; ///< Label the next unseen digit gets
+            bool transpose;
+        };
+
+        /**
+         * @brief Minlex search over the symmetry group, one image row at a time.
+         *
+         * <p>
+         * Row 0 fixes the columns: in a valid puzzle the relabelled digits of a
+         * first row are always 1, 2, 3, ..., so only its pattern of empty cells
+         * matters, and only the column orders giving the smallest pattern are
+         * kept. Every later row extends each surviving candidate with each
+         * source row the band structure allows and keeps the ties of the
+         * smallest relabelled row.
+         * </p>
+         */
+        class Canonicalizer {
+        public:
+            Canonicalizer() {
+                current_.reserve(canonical_candidate_limit);
+                next_.reserve(canonical_candidate_limit);
+            }
+
+            void run(const int8_t *puzzle, Canonical &out) {
+                for (uint8_t i = 0; i < 81; ++i) {
+                    grids_[0][i] = static_cast<uint8_t>(puzzle[i] >= 1 && puzzle[i] <= 9 ? puzzle[i] : 0);
+                    grids_[1][(i % 9) * 9 + i / 9] = grids_[0][i];
+                }
+                truncated_ = false;
+                seed_first_row();
+                std::memcpy(out.grid, best_, 9);
+
+                for (uint8_t layer = 1; layer < 9; ++layer) {
+                    current_.swap(next_);
+                    if (truncated_) current_.resize(1); // inexact anyway: finish greedily
+                    next_.clear();
+                    have_best_ = false;
+                    for (const CanonicalCandidate &candidate: current_) {
+                        if (layer % 3) { // the rest of the current band
+                            const uint8_t band = candidate.rows[layer - 1] / 3;
+                            for (uint8_t r = band * 3; r < band * 3 + 3; ++r)
+                                if (!used(candidate, layer, r)) offer(candidate, layer, r);
+                        } else { // any row of a band not used yet
+                            for (uint8_t r = 0; r < 9; ++r)
+                                if (!used(candidate, layer, r)) offer(candidate, layer, r);
+                        }
+                    }
+                    std::memcpy(out.grid + layer * 9, best_, 9);
+                }
+
+                const CanonicalCandidate &winner = next_.front();
+                Transform &t = out.transform;
+                t.transpose = winner.transpose;
+                std::memcpy(t.rows, winner.rows, 9);
+                std::memcpy(t.cols, winner.cols, 9);
+                std::memcpy(t.digits, winner.digits, 10);
+                uint8_t label = winner.next_label; // digits absent from the puzzle take the remaining labels
+                for (uint8_t d = 1; d <= 9; ++d)
+                    if (!t.digits[d]) t.digits[d] = label++;
+                out.exact = !truncated_;
+            }
+
+        private:
+            /// Whether source row <code>r</code> is unavailable at image row <code>layer</code>
+            static bool used(const CanonicalCandidate &candidate, const uint8_t layer, const uint8_t r) noexcept {
+                for (uint8_t k = 0; k < layer; ++k) {
+                    if (candidate.rows[k] == r) return true;
+                    if (layer % 3 == 0 && candidate.rows[k] / 3 == r / 3) return true; // band already placed
+                }
+                return false;
+            }
+
+            /// Row 0: the pattern-minimal rows with every column order that attains the minimum
+            void seed_first_row() {
+                uint16_t best_pattern = 0x1FF;
+                for (uint8_t t = 0; t < 2; ++t)
+                    for (uint8_t r = 0; r < 9; ++r) {
+                        const uint16_t pattern = smallest_pattern(grids_[t] + r * 9);
+                        if (pattern < best_pattern) best_pattern = pattern;
+                    }
+
+                next_.clear();
+                have_best_ = false;
+                CanonicalCandidate base{};
+                base.next_label = 1;
+                for (uint8_t t = 0; t < 2; ++t)
+                    for (uint8_t r = 0; r < 9; ++r) {
+                        const uint8_t *row = grids_[t] + r * 9;
+                        if (smallest_pattern(row) != best_pattern) continue;
+                        base.transpose = t != 0;
+
+                        // Stacks go from most to fewest empty cells, empty cells first within a stack
+                        uint8_t empty[3];
+                        uint8_t within[3][6], within_count[3] = {};
+                        for (uint8_t s = 0; s < 3; ++s) {
+                            const uint8_t *cells = row + s * 3;
+                            empty[s] = static_cast<uint8_t>(!cells[0] + !cells[1] + !cells[2]);
+                            for (uint8_t o = 0; o < 6; ++o) {
+                                const uint8_t *order = triple_orders[o];
+                                if ((cells[order[0]] && !cells[order[1]]) || (cells[order[1]] && !cells[order[2]])) continue;
+                                within[s][within_count[s]++] = o;
+                            }
+                        }
+                        for (const auto &stacks: triple_orders) {
+                            if (empty[stacks[0]] < empty[stacks[1]] || empty[stacks[1]] < empty[stacks[2]]) continue;
+                            const uint8_t s0 = stacks[0], s1 = stacks[1], s2 = stacks[2];
+                            for (uint8_t a = 0; a < within_count[s0]; ++a) {
+                                place(base, 0, s0, within[s0][a]);
+                                for (uint8_t b = 0; b < within_count[s1]; ++b) {
+                                    place(base, 1, s1, within[s1][b]);
+                                    for (uint8_t c = 0; c < within_count[s2]; ++c) {
+                                        place(base, 2, s2, within[s2][c]);
+                                        offer(base, 0, r);
+                                    }
+                                }
+                            }
+                        }
+                    }
+            }
+
+            /// Put source stack <code>stack</code>, in order <code>order</code>, at image stack <code>at</code>
+            static void place(CanonicalCandidate &candidate, const uint8_t at, const uint8_t stack,
+                              const uint8_t order) noexcept {
+                for (uint8_t k = 0; k < 3; ++k)
+                    candidate.cols[at * 3 + k] = static_cast<uint8_t>(stack * 3 + triple_orders[order][k]);
+            }
+
+            /// Smallest clue pattern (bit 8 = first column) a row reaches under column permutations
+            static uint16_t smallest_pattern(const uint8_t *row) noexcept {
+                uint8_t empty[3];
+                for (uint8_t s = 0; s < 3; ++s)
+                    empty[s] = static_cast<uint8_t>(!row[s * 3] + !row[s * 3 + 1] + !row[s * 3 + 2]);
+                if (empty[0] < empty[1]) std::swap(empty[0], empty[1]);
+                if (empty[1] < empty[2]) std::swap(empty[1], empty[2]);
+                if (empty[0] < empty[1]) std::swap(empty[0], empty[1]);
+                uint16_t pattern = 0;
+                for (const uint8_t e: empty) pattern = static_cast<uint16_t>(pattern << 3 | (0b111u >> e));
+                return pattern;
+            }
+
+            /// Extend <code>base</code> with source row <code>r</code> at image row <code>layer</code>; keep it if it ties the best
+            void offer(const CanonicalCandidate &base, const uint8_t layer, const uint8_t r) {
+                const uint8_t *row = grids_[base.transpose] + r * 9;
+                uint8_t digits[10];
+                std::memcpy(digits, base.digits, 10);
+                uint8_t next_label = base.next_label;
+                uint8_t line[9];
+                bool smaller = !have_best_;
+                for (uint8_t j = 0; j < 9; ++j) {
+                    const uint8_t v = row[base.cols[j]];
+                    uint8_t label = 0;
+                    if (v) {
+                        if (!digits[v]) digits[v] = next_label++;
+                        label = digits[v];
+                    }
+                    if (!smaller) {
+                        if (label > best_[j]) return;
+                        if (label < best_[j]) smaller = true;
+                    }
+                    line[j] = label;
+                }
+                if (smaller) {
+                    std::memcpy(best_, line, 9);
+                    have_best_ = true;
+                    next_.clear();
+                }
+                if (next_.size() == canonical_candidate_limit) {
+                    truncated_ = true;
+                    return;
+                }
+                CanonicalCandidate &candidate = next_.emplace_back(base);
+                candidate.rows[layer] = r;
+                std::memcpy(candidate.digits, digits, 10);
+                candidate.next_label = next_label;
+            }
+
+            uint8_t grids_[2][81]{}; ///< The puzzle and its transpose
+            std::vector<CanonicalCandidate> current_, next_;
+            uint8_t best_[9]{};
+            bool have_best_ = false;
+            bool truncated_ = false;
+        };
+    }
+
+    /**
+     * @brief Minlex form of an 81-cell puzzle (0 for empty, 1–9 for digits) and the transform to it.
+     *
+     * <p>
+     * Exact for valid puzzles unless <code>Canonical::exact</code> says
+     * otherwise. Uses a per-thread search buffer, allocated on first use.
+     * </p>
+     */
+    inline Canonical canonicalize(const int8_t *puzzle) {
+        thread_local detail::Canonicalizer canonicalizer;
+        Canonical out{};
+        canonicalizer.run(puzzle, out);
+        return out;
+    }
+
+    /**
+     * @brief Minlex form of a board's confirmed cells and the transform to it.
+     */
+    inline Canonical canonicalize(const Board &puzzle) {
+        int8_t grid[81];
+        for (uint8_t i = 0; i < 81; ++i) grid[i] = puzzle.cells[i].getConfirmedValue();
+        return canonicalize(grid);
+    }
+
+    // =========================
+    //   SOLUTION CACHE
+    // =========================
+
+    /**
+     * @brief Lookup totals of a <code>SolutionCache</code>.
+     */
+    struct CacheStats {
+        uint64_t hits;            ///< Answered from an entry for the same puzzle
+        uint64_t isomorphic_hits; ///< Answered from an entry for an isomorphic puzzle
+        uint64_t misses;          ///< Solved by a search
+    };
+
+    /**
+     * @brief Fixed-size, lock-striped cache of solved 9x9 puzzles.
+     *
+     * <p>
+     * Every slot holds one packed puzzle and its packed solution (all zero for an
+     * unsolvable puzzle); a slot is picked by hash and a newer entry overwrites an
+     * older one. A search stores two entries, one for the puzzle as given and one
+     * for its canonical form, so exact repeats never pay for canonicalization.
+     * </p>
+     * <p>
+     * One cache may be shared by any number of threads, each solving with its own
+     * workspace; slots are guarded by <code>stripe_count</code> mutexes (none when
+     * <code>SD_ENABLE_THREADS</code> is 0). Storage is allocated once, in the
+     * constructor. A puzzle with several solutions yields one of them, not
+     * necessarily the one <code>solve()</code> would have found.
+     * </p>
+     */
+    class SolutionCache {
+    public:
+        static constexpr std::size_t stripe_count = 64;
+
+        /**
+         * @param slots Number of entries, rounded up to a power of two (at least <code>stripe_count</code>).
+         */
+        explicit SolutionCache(const std::size_t slots = std::size_t{1} << 16) : mask_(round_up(slots) - 1),
+                                                                                 entries_(mask_ + 1) {}
+
+        /**
+         * @brief Solve one 81-cell puzzle buffer in place, through the cache.
+         * @return As <code>sd::solve_puzzle()</code>; invalid puzzles are never cached.
+         */
+        Status solve_puzzle(int8_t *puzzle, SolverWorkspace &workspace, const SolveOptions &options = SolveOptions{}) {
+            Board board{};
+            board.load_int8_t(puzzle);
+            if (!board.check_initial_valid()) return Status::invalid_puzzle;
+
+            Entry entry{};
+            pack_int8_t(puzzle, entry.puzzle);
+            entry.key = hash(entry.puzzle);
+            if (find(entry)) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return answer(entry.solution, puzzle);
+            }
+
+            const Canonical canonical = canonicalize(puzzle);
+            Entry image{};
+            pack_int8_t(canonical.grid, image.puzzle);
+            image.key = hash(image.puzzle);
+            int8_t grid[81], mapped[81];
+            if (find(image)) {
+                isomorphic_hits_.fetch_add(1, std::memory_order_relaxed);
+                unpack_int8_t(image.solution, mapped);
+                if (mapped[0]) {
+                    canonical.transform.restore(mapped, grid);
+                    pack_int8_t(grid, entry.solution);
+                }
+                store(entry);
+                return answer(entry.solution, puzzle);
+            }
+
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            if (sd::solve(board, workspace, options)) {
+                for (uint8_t i = 0; i < 81; ++i) grid[i] = board.cells[i].getConfirmedValue();
+                pack_int8_t(grid, entry.solution);
+                canonical.transform.apply(grid, mapped);
+                pack_int8_t(mapped, image.solution);
+            }
+            store(entry);
+            store(image);
+            return answer(entry.solution, puzzle);
+        }
+
+        /**
+         * @brief Solve a board in place, through the cache.
+         * @return As <code>solve_puzzle()</code>.
+         */
+        Status solve(Board &board, SolverWorkspace &workspace, const SolveOptions &options = SolveOptions{}) {
+            int8_t grid[81];
+            for (uint8_t i = 0; i < 81; ++i) grid[i] = board.cells[i].getConfirmedValue();
+            const Status status = solve_puzzle(grid, workspace, options);
+            if (status == Status::solved) board.load_int8_t(grid);
+            return status;
+        }
+
+        [[nodiscard]] CacheStats stats() const noexcept {
+            return {hits_.load(std::memory_order_relaxed), isomorphic_hits_.load(std::memory_order_relaxed),
+                    misses_.load(std::memory_order_relaxed)};
+        }
+
+        /// Drop every entry and reset the totals
+        void clear() {
+            for (std::size_t slot = 0; slot <= mask_; ++slot) {
+#if SD_ENABLE_THREADS
+                std::lock_guard<std::mutex> lock(stripes_[slot % stripe_count]);
+#endif
+                entries_[slot] = Entry{};
+            }
+            hits_ = isomorphic_hits_ = misses_ = 0;
+        }
+
+    private:
+        struct Entry {
+            uint64_t key;                  ///< Hash of <code>puzzle</code>; 0 for an empty slot
+            uint8_t puzzle[packed_size];
+            uint8_t solution[packed_size]; ///< All zero if the puzzle has no solution
+        };
+
+        static std::size_t round_up(const std::size_t slots) noexcept {
+            std::size_t size = stripe_count;
+            while (size < slots) size <<= 1;
+            return size;
+        }
+
+        static uint64_t hash(const uint8_t *packed) noexcept {
+            uint64_t h = 0x9E3779B97F4A7C15ull;
+            for (std::size_t i = 0; i < 40; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, packed + i, 8);
+                h = (h ^ word) * 0xFF51AFD7ED558CCDull;
+                h ^= h >> 32;
+            }
+            h = (h ^ packed[40]) * 0xC4CEB9FE1A85EC53ull;
+            return (h ^ h >> 29) | uint64_t{1} << 63;
+        }
+
+        /// Copy the solution of the slot holding <code>entry.puzzle</code>, if any
+        bool find(Entry &entry) const {
+            const std::size_t slot = entry.key & mask_;
+#if SD_ENABLE_THREADS
+            std::lock_guard<std::mutex> lock(stripes_[slot % stripe_count]);
+#endif
+            const Entry &held = entries_[slot];
+            if (held.key != entry.key || std::memcmp(held.puzzle, entry.puzzle, packed_size) != 0) return false;
+            std::memcpy(entry.solution, held.solution, packed_size);
+            return true;
+        }
+
+        void store(const Entry &entry) {
+            const std::size_t slot = entry.key & mask_;
+#if SD_ENABLE_THREADS
+            std::lock_guard<std::mutex> lock(stripes_[slot % stripe_count]);
+#endif
+            entries_[slot] = entry;
+        }
+
+        static Status answer(const uint8_t *solution, int8_t *puzzle) noexcept {
+            if (!(solution[0] & 0xF)) return Status::unsolvable;
+            unpack_int8_t(solution, puzzle);
+            return Status::solved;
+        }
+
+        std::size_t mask_;
+        std::vector<Entry> entries_;
+#if SD_ENABLE_THREADS
+        mutable std::mutex stripes_[stripe_count];
+#endif
+        std::atomic<uint64_t> hits_{0}, isomorphic_hits_{0}, misses_{0};
+    };
+SD_END_NAMESPACE
@@ -0,0 +1,305 @@
+/**
+ * @file sd_stream.hpp
+ * @author JeongHan-Bae
+ * @email &lt;mastropseudo&#64;gmail.com&gt;
+ * @brief Streaming front end for line-per-puzzle corpora
+ *
+ * <h3>Description</h3>
+ * <p>
+ * Solves puzzle files in the common 81-character text format: one puzzle per
+ * line, <code>'1'</code>–<code>'9'</code> for givens and any other character
+ * for an empty cell (the format of <code>sd::Board::load</code>). Input is read
+ * in large chunks and parsed in place; puzzles of a chunk are solved as one
+ * batch, optionally on several threads, and the solutions are written to an
+ * output buffer that is flushed once per chunk. All buffers are allocated once
+ * per <code>StreamSolver</code>, never per line.
+ * </p>
+ * <p>
+ * Either side may instead use the packed 41-byte records of
+ * <code>sd::pack</code>; puzzles are held in that form internally regardless,
+ * so a chunk costs 41 bytes per puzzle on top of the input and output buffers.
+ * </p>
+ *
+ * <h3>Line handling</h3>
+ * <ul>
+ *   <li>Lines end with <code>'\n'</code>; a trailing <code>'\r'</code> is ignored.</li>
+ *   <li>Only the first 81 characters of a line are read, so
+ *       <code>puzzle,solution</code> CSV rows and trailing comments work.</li>
+ *   <li>Shorter non-empty lines (headers, comments) are counted and skipped.</li>
+ *   <li>Every puzzle produces exactly one output line, in input order: the
+ *       solution if solved, otherwise the puzzle itself with <code>'.'</code>
+ *       for empty cells.</li>
+ * </ul>
+ *
+ * <h3>License</h3>
+ * <p>
+ * <b>MIT License</b><br/>
+ * Copyright (c) 2025 JeongHan-Bae
+ * </p>
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "sudok_solver.hpp"
+
+SD_BEGIN_NAMESPACE
+    /**
+     * @brief Record layout of a stream.
+     */
+    enum class StreamFormat : uint8_t {
+        text,   ///< One 81-character line per puzzle
+        packed  ///< Back-to-back <code>packed_size</code>-byte records, no separators
+    };
+
+    /**
+     * @brief Settings for the streaming solver.
+     */
+    struct StreamOptions {
+        std::size_t chunk_bytes = std::size_t{4} << 20; ///< Input read per step (at least 4 KiB)
+        unsigned threads = 1;                          ///< Workers per chunk; 0 uses all hardware threads
+        std::size_t batch_chunk = 64;                  ///< Puzzles a worker claims at a time
+        StreamFormat input = StreamFormat::text;       ///< Layout of the input
+        StreamFormat output = StreamFormat::text;      ///< Layout of the solutions written to the sink
+        SolveOptions solve{};                          ///< Per-puzzle solver settings
+    };
+
+    /**
+     * @brief Running totals of a stream.
+     */
+    struct StreamStats {
+        uint64_t puzzles = 0;        ///< Puzzle lines read
+        uint64_t solved = 0;         ///< <code>Status::solved</code>
+        uint64_t invalid = 0;        ///< <code>Status::invalid_puzzle</code>
+        uint64_t unsolvable = 0;     ///< <code>Status::unsolvable</code>
+        uint64_t skipped_lines = 0;  ///< Non-empty lines shorter than 81 characters, or a partial last record
+        bool io_error = false;       ///< A read failed or the sink refused output
+    };
+
+    /**
+     * @brief Chunked text-to-solution pipeline with buffers allocated once.
+     *
+     * <p>
+     * <code>feed()</code> consumes complete lines from a caller-owned text range,
+     * so the same object serves <code>std::FILE</code> input, memory-mapped files
+     * and in-memory buffers alike.
+     * </p>
+     */
+    class StreamSolver {
+    public:
+        explicit StreamSolver(const StreamOptions &options = StreamOptions{})
+            : options_(options),
+              capacity_(options.chunk_bytes < 4096 ? 4096 : options.chunk_bytes),
+              max_puzzles_(capacity_ / record_size(options.input) + 1),
+              records_(max_puzzles_ * packed_size),
+              statuses_(max_puzzles_),
+              out_(max_puzzles_ * record_size(options.output)) {}
+
+        /// Bytes of input <code>solve_stream()</code> reads per step
+        [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+        [[nodiscard]] const StreamStats &stats() const noexcept { return stats_; }
+
+        /**
+         * @brief Solve the complete lines (or packed records) at the start of <code>[begin, end)</code>.
+         *
+         * <p>
+         * At most one batch (<code>capacity()</code> divided by the record size,
+         * plus one) is handled per call; the caller loops until the returned
+         * pointer stops advancing.
+         * </p>
+         *
+         * @param begin Start of the input.
+         * @param end End of the input.
+         * @param final If true, a last line without <code>'\n'</code> is consumed too
+         *              (a partial packed record is counted as skipped).
+         * @param sink Callable <code>bool(const char *data, std::size_t size)</code>; false aborts.
+         * @return First byte not consumed (the start of an incomplete line, or <code>end</code>).
+         */
+        template<typename Sink>
+        const char *feed(const char *begin, const char *end, const bool final, Sink &sink) {
+            const char *p = begin;
+            std::size_t count = 0;
+            if (options_.input == StreamFormat::packed) {
+                std::size_t available = static_cast<std::size_t>(end - begin) / packed_size;
+                count = available < max_puzzles_ ? available : max_puzzles_;
+                std::memcpy(records_.data(), begin, count * packed_size);
+                p = begin + count * packed_size;
+                if (final && count < max_puzzles_ && p != end) {
+                    ++stats_.skipped_lines;
+                    p = end;
+                }
+                if (count && !flush(count, sink)) stats_.io_error = true;
+                return p;
+            }
+            while (p < end && count < max_puzzles_) {
+                const auto *newline = static_cast<const char *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+                if (!newline && !final) break;
+                const char *line_end = newline ? newline : end;
+                std::size_t length = static_cast<std::size_t>(line_end - p);
+                if (length && p[length - 1] == '\r') --length;
+                if (length >= 81) {
+                    parse(p, records_.data() + count * packed_size);
+                    ++count;
+                } else if (length) {
+                    ++stats_.skipped_lines;
+                }
+                p = newline ? newline + 1 : end;
+            }
+            if (count && !flush(count, sink)) stats_.io_error = true;
+            return p;
+        }
+
+    private:
+        static constexpr std::size_t record_size(const StreamFormat format) noexcept {
+            return format == StreamFormat::text ? 82 : packed_size;
+        }
+
+        static uint8_t text_digit(const char ch) noexcept {
+            return static_cast<uint8_t>(ch >= '1' && ch <= '9' ? ch - '0' : 0);
+        }
+
+        /// Text goes straight to the packed form the batch is solved in
+        static void parse(const char *text, uint8_t *record) noexcept {
+            for (uint8_t i = 0; i < 40; ++i)
+                record[i] = static_cast<uint8_t>(text_digit(text[i * 2]) | text_digit(text[i * 2 + 1]) << 4);
+            record[40] = text_digit(text[80]);
+        }
+
+        template<typename Sink>
+        bool flush(const std::size_t count, Sink &sink) {
+#if SD_ENABLE_THREADS
+            if (options_.threads != 1) {
+                ParallelOptions parallel{};
+                parallel.threads = options_.threads;
+                parallel.chunk = options_.batch_chunk;
+                parallel.solve = options_.solve;
+                solve_batch_packed_parallel(records_.data(), count, statuses_.data(), parallel);
+            } else
+#endif
+            {
+                solve_batch_packed(records_.data(), count, statuses_.data(), detail::default_workspace(),
+                                   options_.solve);
+            }
+
+            char *out = out_.data();
+            for (std::size_t i = 0; i < count; ++i) {
+                const uint8_t *record = records_.data() + i * packed_size;
+                if (options_.output == StreamFormat::packed) {
+                    std::memcpy(out, record, packed_size);
+                    out += packed_size;
+                } else {
+                    for (uint8_t c = 0; c < 81; ++c) {
+                        const uint8_t digit = static_cast<uint8_t>(record[c >> 1] >> (c & 1) * 4 & 0xF);
+                        out[c] = digit && digit <= 9 ? static_cast<char>('0' + digit) : '.';
+                    }
+                    out[81] = '\n';
+                    out += 82;
+                }
+                switch (statuses_[i]) {
+                    case Status::solved: ++stats_.solved; break;
+                    case Status::invalid_puzzle: ++stats_.invalid; break;
+                    default: ++stats_.unsolvable; break;
+                }
+            }
+            stats_.puzzles += count;
+            return sink(static_cast<const char *>(out_.data()), count * record_size(options_.output));
+        }
+
+        StreamOptions options_;
+        std::size_t capacity_;
+        std::size_t max_puzzles_;
+        std::vector<uint8_t> records_;
+        std::vector<Status> statuses_;
+        std::vector<char> out_;
+        StreamStats stats_{};
+    };
+
+    /**
+     * @brief Solve every puzzle of an in-memory (or memory-mapped) text buffer.
+     * @param text Puzzle text, one puzzle per line.
+     * @param size Bytes of <code>text</code>.
+     * @param sink Callable <code>bool(const char *data, std::size_t size)</code> receiving solution lines.
+     * @param options Chunk size, threads and solver settings.
+     * @return Totals of the stream.
+     */
+    template<typename Sink>
+    StreamStats solve_buffer(const char *text, const std::size_t size, Sink &&sink,
+                             const StreamOptions &options = StreamOptions{}) {
+        StreamSolver solver(options);
+        const char *p = text;
+        const char *const end = text + size;
+        while (p < end && !solver.stats().io_error) p = solver.feed(p, end, true, sink);
+        return solver.stats();
+    }
+
+    /**
+     * @brief Solve every puzzle read from <code>in</code>, chunk by chunk.
+     *
+     * <p>
+     * A line longer than the whole read buffer keeps its first 81 characters;
+     * the rest of it is discarded.
+     * </p>
+     *
+     * @param in Input stream, read with <code>std::fread</code>.
+     * @param sink Callable <code>bool(const char *data, std::size_t size)</code> receiving solution lines.
+     * @param options Chunk size, threads and solver settings.
+     * @return Totals of the stream.
+     */
+    template<typename Sink>
+    StreamStats solve_stream(std::FILE *in, Sink &&sink, const StreamOptions &options = StreamOptions{}) {
+        StreamSolver solver(options);
+        std::vector<char> text(solver.capacity());
+        std::size_t filled = 0;
+        bool skipping = false; // inside the tail of an over-long line
+        bool eof = false;
+        while (!eof && !solver.stats().io_error) {
+            const std::size_t got = std::fread(text.data() + filled, 1, text.size() - filled, in);
+            if (got == 0) {
+                if (std::ferror(in)) {
+                    StreamStats stats = solver.stats();
+                    stats.io_error = true;
+                    return stats;
+                }
+                eof = true;
+            }
+            filled += got;
+
+            const char *p = text.data();
+            const char *const end = p + filled;
+            if (skipping) {
+                const auto *newline = static_cast<const char *>(std::memchr(p, '\n', filled));
+                if (!newline) {
+                    filled = 0;
+                    continue;
+                }
+                skipping = false;
+                p = newline + 1;
+            }
+            for (const char *next; !solver.stats().io_error && (next = solver.feed(p, end, eof, sink)) != p;) p = next;
+
+            std::size_t tail = static_cast<std::size_t>(end - p);
+            if (tail == text.size()) { // no line break in a full text buffer
+                solver.feed(p, p + 81, true, sink);
+                skipping = true;
+                tail = 0;
+            }
+            std::memmove(text.data(), p, tail);
+            filled = tail;
+        }
+        return solver.stats();
+    }
+
+    /**
+     * @brief Solve a puzzle stream into an output stream.
+     * @return Totals of the stream; <code>io_error</code> is set if a read or write failed.
+     */
+    inline StreamStats solve_stream(std::FILE *in, std::FILE *out, const StreamOptions &options = StreamOptions{}) {
+        return solve_stream(in, [out](const char *data, const std::size_t size) {
+            return std::fwrite(data, 1, size, out) == size;
+        }, options);
+    }
+SD_END_NAMESPACE
@@ -0,0 +1,154 @@
+/**
+ * @file sd_c_dispatch.cpp
+ * @brief Exported C ABI of libsudoklite: runtime kernel selection and forwarding.
+ *
+ * <p>
+ * Each exported function forwards to the kernel chosen on the first call: the
+ * highest instruction-set level the CPU and OS support, unless the
+ * <code>SUDOKLITE_KERNEL</code> environment variable names another kernel the
+ * CPU can run. The choice is made once per process, so every later call costs
+ * one indirect jump.
+ * </p>
+ */
+
+#define SUDOKLITE_BUILDING_LIBRARY
+#include "sd_c_kernel.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifndef SUDOKLITE_X86_KERNELS
+#define SUDOKLITE_X86_KERNELS 0
+#endif
+
+namespace sudoklite {
+    extern const Kernel kernel_baseline;
+#if SUDOKLITE_X86_KERNELS
+    extern const Kernel kernel_avx2;
+    extern const Kernel kernel_avx512;
+#endif
+
+    namespace {
+        struct Candidate {
+            const Kernel &kernel;
+            bool (*runs_here)();
+        };
+
+#if SUDOKLITE_X86_KERNELS
+        // Feature sets of the -m flags each kernel is built with (CMakeLists.txt)
+        bool runs_avx2() {
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+                   __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("popcnt");
+        }
+
+        bool runs_avx512() {
+            return runs_avx2() && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512vl");
+        }
+#endif
+
+        bool runs_anywhere() { return true; }
+
+        /// Most capable first
+        const Candidate candidates[] = {
+#if SUDOKLITE_X86_KERNELS
+                {kernel_avx512, &runs_avx512},
+                {kernel_avx2, &runs_avx2},
+#endif
+                {kernel_baseline, &runs_anywhere},
+        };
+
+        const Kernel &select_kernel() {
+#if SUDOKLITE_X86_KERNELS
+            __builtin_cpu_init();
+#endif
+            if (const char *forced = std::getenv("SUDOKLITE_KERNEL"))
+                for (const Candidate &candidate: candidates)
+                    if (std::strcmp(forced, candidate.kernel.kernel_name()) == 0 && candidate.runs_here())
+                        return candidate.kernel;
+            for (const Candidate &candidate: candidates)
+                if (candidate.runs_here()) return candidate.kernel;
+            return kernel_baseline;
+        }
+
+        const Kernel &kernel() {
+            static const Kernel &selected = select_kernel();
+            return selected;
+        }
+    }
+}
+
+extern "C" {
+    sd_status_t sudoku_solve_c(sudoku_puzzle_t *puzzle) {
+        return sudoklite::kernel().solve_c(puzzle);
+    }
+
+    sd_status_t sudoku_solve_stats(sudoku_puzzle_t *puzzle, sudoku_stats_t *stats) {
+        return sudoklite::kernel().solve_stats(puzzle, stats);
+    }
+
+    sd_status_t sudoku_solve_limited(sudoku_puzzle_t *puzzle, uint64_t max_nodes, uint64_t timeout_us) {
+        return sudoklite::kernel().solve_limited(puzzle, max_nodes, timeout_us);
+    }
+
+    const char *sudoku_status_message(sd_status_t status) {
+        return sudoklite::kernel().status_message(status);
+    }
+
+    const char *sudoku_solver_c(sudoku_puzzle_t *puzzle) {
+        return sudoklite::kernel().solver_c(puzzle);
+    }
+
+    size_t sudoku_solve_batch(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status) {
+        return sudoklite::kernel().solve_batch(puzzles, n, out_status);
+    }
+
+    uint32_t sudoku_count_solutions(const sudoku_puzzle_t *puzzle, uint32_t limit) {
+        return sudoklite::kernel().count_solutions(puzzle, limit);
+    }
+
+    int sudoku_has_unique_solution(const sudoku_puzzle_t *puzzle) {
+        return sudoklite::kernel().has_unique_solution(puzzle);
+    }
+
+    sd_verdict_t sudoku_triage(const sudoku_puzzle_t *puzzle, sudoku_triage_t *out) {
+        return sudoklite::kernel().triage(puzzle, out);
+    }
+
+    void sudoku_candidates_init(sudoku_candidates_t *grid, const sudoku_puzzle_t *puzzle) {
+        sudoklite::kernel().candidates_init(grid, puzzle);
+    }
+
+    int sudoku_candidates_place(sudoku_candidates_t *grid, uint8_t cell, uint8_t digit,
+                                sudoku_candidate_update_t *update) {
+        return sudoklite::kernel().candidates_place(grid, cell, digit, update);
+    }
+
+    uint32_t sudoku_generate(sudoku_puzzle_t *puzzle, sudoku_puzzle_t *solution, uint64_t seed,
+                             uint32_t target_clues, uint32_t min_guesses) {
+        return sudoklite::kernel().generate(puzzle, solution, seed, target_clues, min_guesses);
+    }
+
+    void sudoku_pack(const sudoku_puzzle_t *puzzle, sudoku_packed_t *packed) {
+        sudoklite::kernel().pack(puzzle, packed);
+    }
+
+    void sudoku_unpack(const sudoku_packed_t *packed, sudoku_puzzle_t *puzzle) {
+        sudoklite::kernel().unpack(packed, puzzle);
+    }
+
+    size_t sudoku_solve_batch_packed(sudoku_packed_t *puzzles, size_t n, sd_status_t *out_status) {
+        return sudoklite::kernel().solve_batch_packed(puzzles, n, out_status);
+    }
+
+    size_t sudoku_solve_batch_parallel(sudoku_puzzle_t *puzzles, size_t n, sd_status_t *out_status,
+                                       unsigned threads, size_t chunk) {
+        const sudoklite::Kernel &kernel = sudoklite::kernel();
+        if (!kernel.solve_batch_parallel) return kernel.solve_batch(puzzles, n, out_status);
+        return kernel.solve_batch_parallel(puzzles, n, out_status, threads, chunk);
+    }
+
+    const char *sudoku_kernel_name(void) {
+        return sudoklite::kernel().kernel_name();
+    }
+}
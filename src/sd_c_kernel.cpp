@@ -0,0 +1,53 @@
+/**
+ * @file sd_c_kernel.cpp
+ * @brief One instruction-set build of the C API for libsudoklite.
+ *
+ * <p>
+ * Compiled once per kernel with <code>SD_KERNEL_NAMESPACE</code> set to the
+ * kernel name (<code>baseline</code>, <code>avx2</code>, ...) and that
+ * kernel's <code>-m</code> flags. The header-only definitions of
+ * <code>sd_c_api.h</code> are <code>static inline</code> and the solver lives
+ * in <code>sd::SD_KERNEL_NAMESPACE</code>, so the builds share no solver code
+ * and each one is exposed only through its table <code>kernel_&lt;name&gt;</code>.
+ * Only the standard-library inline code they instantiate can be merged by the
+ * linker; the <code>kernel_isolation</code> test checks that the baseline
+ * table reaches no copy of it built for a newer CPU.
+ * </p>
+ */
+
+#include "sd_c_kernel.h"
+
+#ifndef SD_KERNEL_NAMESPACE
+#error "sd_c_kernel.cpp is built once per kernel with SD_KERNEL_NAMESPACE=<name>"
+#endif
+
+#define SD_KERNEL_TABLE_NAME(name) kernel_##name
+#define SD_KERNEL_TABLE(name) SD_KERNEL_TABLE_NAME(name)
+
+namespace sudoklite {
+    extern const Kernel SD_KERNEL_TABLE(SD_KERNEL_NAMESPACE);
+
+    const Kernel SD_KERNEL_TABLE(SD_KERNEL_NAMESPACE) = {
+            &sudoku_kernel_name,
+            &sudoku_solve_c,
+            &sudoku_solve_stats,
+            &sudoku_solve_limited,
+            &sudoku_status_message,
+            &sudoku_solver_c,
+            &sudoku_solve_batch,
+            &sudoku_count_solutions,
+            &sudoku_has_unique_solution,
+            &sudoku_triage,
+            &sudoku_candidates_init,
+            &sudoku_candidates_place,
+            &sudoku_generate,
+            &sudoku_pack,
+            &sudoku_unpack,
+            &sudoku_solve_batch_packed,
+#if SD_ENABLE_THREADS
+            &sudoku_solve_batch_parallel,
+#else
+            nullptr,
+#endif
+    };
+}
@@ -0,0 +1,39 @@
+/**
+ * @file sd_c_kernel.h
+ * @brief Function table of one instruction-set build of the C API, as linked into libsudoklite.
+ *
+ * <p>
+ * <code>sd_c_kernel.cpp</code> is compiled once per kernel, each time with its
+ * own instruction-set flags and <code>SD_KERNEL_NAMESPACE</code>, and fills a
+ * <code>Kernel</code> with that build of the header-only C API.
+ * <code>sd_c_dispatch.cpp</code> selects one table on first use and forwards
+ * every exported function to it.
+ * </p>
+ */
+
+#pragma once
+
+#include "sd_c_api.h"
+
+namespace sudoklite {
+    struct Kernel {
+        decltype(&sudoku_kernel_name) kernel_name;
+        decltype(&sudoku_solve_c) solve_c;
+        decltype(&sudoku_solve_stats) solve_stats;
+        decltype(&sudoku_solve_limited) solve_limited;
+        decltype(&sudoku_status_message) status_message;
+        decltype(&sudoku_solver_c) solver_c;
+        decltype(&sudoku_solve_batch) solve_batch;
+        decltype(&sudoku_count_solutions) count_solutions;
+        decltype(&sudoku_has_unique_solution) has_unique_solution;
+        decltype(&sudoku_triage) triage;
+        decltype(&sudoku_candidates_init) candidates_init;
+        decltype(&sudoku_candidates_place) candidates_place;
+        decltype(&sudoku_generate) generate;
+        decltype(&sudoku_pack) pack;
+        decltype(&sudoku_unpack) unpack;
+        decltype(&sudoku_solve_batch_packed) solve_batch_packed;
+        /// <code>nullptr</code> when built without thread support
+        size_t (*solve_batch_parallel)(sudoku_puzzle_t *, size_t, sd_status_t *, unsigned, size_t);
+    };
+}
@@ -86,7 +86,33 @@
 #include <cstddef>
 #include <iostream>
 #include <cstring>
-#include <memory>      // NOLINT for std::unique_ptr
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <chrono>
+
+
+/**
+ * <h3>Kernel Namespace</h3>
+ * <p>
+ * Every declaration below lives in <code>namespace sd</code>. Defining
+ * <code>SD_KERNEL_NAMESPACE</code> (for example
+ * <code>-DSD_KERNEL_NAMESPACE=avx2</code>) nests it in an inline namespace of
+ * that name. Translation units built for different instruction sets can then
+ * be linked into one binary without the linker merging their inline
+ * functions, while code still names everything <code>sd::</code>. The shared
+ * library's dispatched kernels rely on this; header-only builds leave it
+ * undefined.
+ * </p>
+ */
+
+#ifdef SD_KERNEL_NAMESPACE
+#  define SD_BEGIN_NAMESPACE namespace sd { inline namespace SD_KERNEL_NAMESPACE {
+#  define SD_END_NAMESPACE } }
+#else
+#  define SD_BEGIN_NAMESPACE namespace sd {
+#  define SD_END_NAMESPACE }
+#endif
 
 
 /**
@@ -123,12 +149,12 @@
 #if SD_USE_JH_POD
 #include <jh/pod>
 
-namespace sd {
+SD_BEGIN_NAMESPACE
     using jh::pod::pod_like;
     using jh::pod::array;
-}
+SD_END_NAMESPACE
 #else
-namespace sd {
+SD_BEGIN_NAMESPACE
     namespace detail {
         /**
          * @brief Compile-time trait to check if a type is POD-like.
@@ -183,10 +209,172 @@ namespace sd {
     }
     template<typename T, std::uint16_t N>
     using array = detail::array_impl<T, N>;
-}
+SD_END_NAMESPACE
+#endif
+
+
+/**
+ * <h3>SIMD Kernel Selection</h3>
+ * <p>
+ * The full-board deduction sweep (<code>Board::deduce_once()</code>) has a
+ * vectorised kernel operating on 8 cells (16-bit lanes) per register. Every
+ * solve runs it on the root board, inside <code>Board::propagate_all()</code>,
+ * before the worklist takes over. The instruction set is chosen at compile
+ * time from the target:
+ * </p>
+ *
+ * <ul>
+ *   <li><code>SD_SIMD_SSE2</code> &nbsp;&mdash;&nbsp; any x86-64 target (SSE2 is baseline)</li>
+ *   <li><code>SD_SIMD_NEON</code> &nbsp;&mdash;&nbsp; AArch64 targets</li>
+ *   <li><code>SD_SIMD_NONE</code> &nbsp;&mdash;&nbsp; portable scalar fallback</li>
+ * </ul>
+ *
+ * <p>
+ * Define <code>SD_SIMD</code> to one of these values (for example
+ * <code>-DSD_SIMD=0</code>) to override the detection.
+ * </p>
+ */
+
+#define SD_SIMD_NONE 0
+#define SD_SIMD_SSE2 1
+#define SD_SIMD_NEON 2
+
+#ifndef SD_SIMD
+#  if defined(__SSE2__) || defined(_M_X64)
+#    define SD_SIMD SD_SIMD_SSE2
+#  elif defined(__ARM_NEON) && defined(__aarch64__)
+#    define SD_SIMD SD_SIMD_NEON
+#  else
+#    define SD_SIMD SD_SIMD_NONE
+#  endif
+#endif
+
+/**
+ * <h3>Thread Support</h3>
+ * <p>
+ * The parallel batch solver uses <code>std::thread</code> and
+ * <code>std::atomic</code>. Define <code>SD_ENABLE_THREADS=0</code> on targets
+ * without thread support; the single-threaded API is unaffected.
+ * </p>
+ */
+
+#ifndef SD_ENABLE_THREADS
+#  define SD_ENABLE_THREADS 1
+#endif
+
+#if SD_ENABLE_THREADS
+#include <algorithm>
+#include <system_error>
+#include <thread>
+#include <vector>
+#endif
+
+/**
+ * <h3>Cycle Timers</h3>
+ * <p>
+ * <code>sd::SolveStats</code> can also time deduction and branch selection.
+ * Define <code>SD_ENABLE_CYCLE_TIMERS=1</code> to read the time-stamp counter
+ * (x86) or <code>std::chrono::steady_clock</code> nanoseconds (elsewhere)
+ * around them; by default the timer fields stay 0 and no clock is read.
+ * </p>
+ */
+
+#ifndef SD_ENABLE_CYCLE_TIMERS
+#  define SD_ENABLE_CYCLE_TIMERS 0
+#endif
+
+#if SD_ENABLE_CYCLE_TIMERS
+#  if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>
+#    define SD_HAS_RDTSC 1
+#  elif defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define SD_HAS_RDTSC 1
+#  else
+#    include <chrono>
+#    define SD_HAS_RDTSC 0
+#  endif
+#endif
+
+/**
+ * <h3>Cache-Aligned Layout</h3>
+ * <p>
+ * Define <code>SD_CACHE_ALIGNED=1</code> to align every board, copy-engine
+ * frame and workspace section to <code>SD_CACHE_LINE</code> (64) bytes. A 9x9
+ * board then fills exactly four lines (256 bytes instead of 218), a frame five.
+ * No frame straddles a line it shares with its neighbour, and boards worked on
+ * by different threads (the per-thread workspaces, the frontier of
+ * <code>solve_parallel_search()</code>, the spans of
+ * <code>solve_parallel()</code>) never share a line. Off by default: boards
+ * grow by about 17% and single-threaded throughput is unchanged.
+ * </p>
+ */
+
+#ifndef SD_CACHE_ALIGNED
+#  define SD_CACHE_ALIGNED 0
+#endif
+
+#ifndef SD_CACHE_LINE
+#  define SD_CACHE_LINE 64
+#endif
+
+#if SD_CACHE_ALIGNED
+#  define SD_CACHE_ALIGN alignas(SD_CACHE_LINE)
+#else
+#  define SD_CACHE_ALIGN
+#endif
+
+/**
+ * <h3>Branch Hints</h3>
+ * <p>
+ * <code>SD_LIKELY</code> / <code>SD_UNLIKELY</code> mark the expected outcome
+ * of a condition. They mark the contradiction exits of the propagation
+ * worklist and the rare exits of the search engines: an invalid root, the stop
+ * poll and a solution being reached. A failed guess is not hinted, because
+ * about half of all guesses fail.
+ * They expand to <code>__builtin_expect</code> on GCC and Clang (also before
+ * C++20, where <code>[[likely]]</code> is unavailable) and to the bare
+ * condition elsewhere. A profile-guided build (see <code>SUDOKLITE_PGO</code>
+ * in <code>CMakeLists.txt</code>) supersedes them with measured frequencies.
+ * </p>
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define SD_LIKELY(x) __builtin_expect(!!(x), 1)
+#  define SD_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#  define SD_LIKELY(x) (x)
+#  define SD_UNLIKELY(x) (x)
+#endif
+
+#if SD_SIMD == SD_SIMD_SSE2
+#include <emmintrin.h>
+#elif SD_SIMD == SD_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * <h3>Constant Evaluation</h3>
+ * <p>
+ * Under C++20 the board, the propagation and every search engine is
+ * <code>constexpr</code>, so puzzles can be solved (and tables or test vectors
+ * built) at compile time. Bit scans fall back to portable loops while being
+ * constant-evaluated, and the SIMD sweep is skipped. <code>SD_CONSTEXPR20</code>
+ * expands to <code>constexpr</code> there and to nothing before C++20;
+ * <code>SD_HAS_CONSTEXPR_SOLVE</code> reports which one applies.
+ * </p>
+ */
+
+#if defined(__cpp_lib_is_constant_evaluated) && __cpp_lib_is_constant_evaluated >= 201811L && \
+    defined(__cpp_constexpr) && __cpp_constexpr >= 201907L
+#  define SD_HAS_CONSTEXPR_SOLVE 1
+#  define SD_CONSTEXPR20 constexpr
+#else
+#  define SD_HAS_CONSTEXPR_SOLVE 0
+#  define SD_CONSTEXPR20
 #endif
 
-namespace sd {
+SD_BEGIN_NAMESPACE
     namespace detail {
         // =========================
         //   BIT OPERATIONS
@@ -198,325 +386,3237 @@ namespace sd {
 #define HAS_BUILTIN_CTZ 0
 #endif
 
+        /**
+         * @brief True while the caller is being constant-evaluated (always false before C++20).
+         */
+        constexpr bool is_constant_evaluated() noexcept {
+#if SD_HAS_CONSTEXPR_SOLVE
+            return std::is_constant_evaluated();
+#else
+            return false;
+#endif
+        }
+
         /**
          * @brief Return the position of the only bit set in a power-of-two mask.
-         * @return Value in [0, 15], or -1 if input is not a power-of-two.
+         * @return Value in [0, 31], or -1 if input is not a power-of-two.
          */
-        inline int8_t get_power_of_two_runtime(std::uint16_t x) {
+        inline SD_CONSTEXPR20 int8_t get_power_of_two_runtime(std::uint32_t x) {
             if (x == 0 || (x & (x - 1)) != 0)
                 return -1;
 
 #if HAS_BUILTIN_CTZ
-            return static_cast<int8_t>(__builtin_ctz(x));
-#else
+            if (!is_constant_evaluated()) return static_cast<int8_t>(__builtin_ctz(x));
+#endif
             int8_t n = 0;
             while (x >>= 1) ++n;
             return n;
+        }
+
+        /**
+         * @brief Return the position of the highest bit set.
+         * @return Value in [0, 31], or -1 if input is 0.
+         */
+        inline SD_CONSTEXPR20 int8_t highest_bit(std::uint32_t x) {
+            if (x == 0) return -1;
+#if HAS_BUILTIN_CTZ
+            if (!is_constant_evaluated()) return static_cast<int8_t>(31 - __builtin_clz(x));
 #endif
+            int8_t n = 0;
+            while (x >>= 1) ++n;
+            return n;
         }
 
         /**
-         * @brief Return the number of bits set in a 16-bit integer.
+         * @brief Return the number of bits set in a 32-bit integer.
          */
-        inline uint8_t popcount16(const std::uint16_t x) {
+        inline SD_CONSTEXPR20 uint8_t popcount32(const std::uint32_t x) {
 #if defined(__GNUC__) || defined(__clang__)
-            return static_cast<uint8_t>(__builtin_popcount(x));
-#else   // MSVC support removed to avoid fragile compilation
+            if (!is_constant_evaluated()) return static_cast<uint8_t>(__builtin_popcount(x));
+#endif  // MSVC support removed to avoid fragile compilation
             uint8_t count = 0;
-            uint16_t val = x;
+            uint32_t val = x;
             while (val) {
                 count += val & 1;
                 val >>= 1;
             }
             return count;
+        }
+
+        /**
+         * @brief Return the number of bits set in a 16-bit integer.
+         */
+        inline SD_CONSTEXPR20 uint8_t popcount16(const std::uint16_t x) {
+            return popcount32(x);
+        }
+
+        /// Popcount of a cell mask, whichever width the board uses
+        inline SD_CONSTEXPR20 uint8_t popcount(const std::uint16_t x) { return popcount16(x); }
+
+        inline SD_CONSTEXPR20 uint8_t popcount(const std::uint32_t x) { return popcount32(x); }
+    }
+
+#if SD_SIMD != SD_SIMD_NONE
+    namespace detail {
+        // =========================
+        //   SIMD PRIMITIVES
+        // =========================
+
+        /**
+         * @brief Minimal 8 x uint16 vector vocabulary used by the deduction kernel.
+         */
+        namespace simd {
+#if SD_SIMD == SD_SIMD_SSE2
+            using vec = __m128i;
+
+            inline vec load(const std::uint16_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+            inline void store(std::uint16_t *p, const vec v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+            inline vec splat(const std::uint16_t x) { return _mm_set1_epi16(static_cast<short>(x)); }
+            inline vec bit_and(const vec a, const vec b) { return _mm_and_si128(a, b); }
+            inline vec bit_or(const vec a, const vec b) { return _mm_or_si128(a, b); }
+            inline vec and_not(const vec a, const vec b) { return _mm_andnot_si128(b, a); } ///< a & ~b
+            inline vec equal(const vec a, const vec b) { return _mm_cmpeq_epi16(a, b); }
+            inline vec sub(const vec a, const vec b) { return _mm_sub_epi16(a, b); }
+            inline vec select(const vec m, const vec a, const vec b) { return bit_or(bit_and(m, a), and_not(b, m)); }
+            inline bool any(const vec m) { return _mm_movemask_epi8(m) != 0; }
+#else
+            using vec = uint16x8_t;
+
+            inline vec load(const std::uint16_t *p) { return vld1q_u16(p); }
+            inline void store(std::uint16_t *p, const vec v) { vst1q_u16(p, v); }
+            inline vec splat(const std::uint16_t x) { return vdupq_n_u16(x); }
+            inline vec bit_and(const vec a, const vec b) { return vandq_u16(a, b); }
+            inline vec bit_or(const vec a, const vec b) { return vorrq_u16(a, b); }
+            inline vec and_not(const vec a, const vec b) { return vbicq_u16(a, b); } ///< a & ~b
+            inline vec equal(const vec a, const vec b) { return vceqq_u16(a, b); }
+            inline vec sub(const vec a, const vec b) { return vsubq_u16(a, b); }
+            inline vec select(const vec m, const vec a, const vec b) { return vbslq_u16(m, a, b); }
+            inline bool any(const vec m) { return vmaxvq_u16(m) != 0; }
 #endif
+            /**
+             * @brief OR of all 8 lanes.
+             */
+            inline std::uint16_t reduce_or(const vec v) {
+                std::uint16_t lanes[8];
+                store(lanes, v);
+                return static_cast<std::uint16_t>(lanes[0] | lanes[1] | lanes[2] | lanes[3] |
+                                                  lanes[4] | lanes[5] | lanes[6] | lanes[7]);
+            }
         }
+
+        /**
+         * @brief Lane selectors for the three boxes of a band (columns 0–7).
+         */
+        alignas(16) inline constexpr std::uint16_t simd_box_lanes[3][8] = {
+                {0xFFFF, 0xFFFF, 0xFFFF, 0, 0, 0, 0, 0},
+                {0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0, 0},
+                {0, 0, 0, 0, 0, 0, 0xFFFF, 0xFFFF}
+        };
     }
+#endif
 
     // =========================
-    //   CELL STRUCTURE
+    //   BOARD GEOMETRY
     // =========================
 
     /**
-     * @brief A single Sudoku cell, encoded as a bitmask.
+     * @brief A single Sudoku cell of a board with <code>Size</code> digits, encoded as a bitmask.
+     *
+     * <p>
+     * Bit 0 marks a confirmed cell and bits 1–<code>Size</code> are the candidate
+     * digits, so the mask needs <code>Size + 1</code> bits: 16 bits up to 15
+     * digits, 32 bits above (16×16 and 25×25 boards).
+     * </p>
      */
-    struct SudokuCell {
-        std::uint16_t state; ///< Bitmask: bit 0 = confirmed, bits 1–9 = candidate digits
+    template<uint8_t Size>
+    struct BasicCell {
+        static_assert(Size >= 1 && Size <= 30, "cell masks hold at most 30 digits");
+
+        using mask_type = typename std::conditional<(Size < 16), std::uint16_t, std::uint32_t>::type;
+
+        static constexpr mask_type full_mask = static_cast<mask_type>(((mask_type{1} << Size) - 1) << 1);
+
+        mask_type state; ///< Bitmask: bit 0 = confirmed, bits 1–Size = candidate digits
 
-        [[nodiscard]] bool isConfirmed() const {
+        [[nodiscard]] SD_CONSTEXPR20 bool isConfirmed() const {
             return state & 0b1;
         }
 
-        [[nodiscard]] std::uint16_t possibleMask() const {
-            return state & 0b1111111110;
+        [[nodiscard]] SD_CONSTEXPR20 mask_type possibleMask() const {
+            return state & full_mask;
         }
 
-        [[nodiscard]] bool isValid() const {
-            const std::uint16_t mask = possibleMask();
+        [[nodiscard]] SD_CONSTEXPR20 bool isValid() const {
+            const mask_type mask = possibleMask();
             if (state == 0) return false;
             if (state == 1) return false;
             if (isConfirmed() && (mask & (mask - 1)) != 0) return false;
             return true;
         }
 
-        [[nodiscard]] int8_t getConfirmedValue() const {
+        [[nodiscard]] SD_CONSTEXPR20 int8_t getConfirmedValue() const {
             if (!isConfirmed()) return 0;
-            const std::uint16_t mask = possibleMask();
+            const mask_type mask = possibleMask();
             if ((mask & mask - 1) != 0) return 0; // ensure single-bit
             return detail::get_power_of_two_runtime(mask);
         }
     };
 
+    /**
+     * @brief A single cell of the classic 9x9 board.
+     */
+    using SudokuCell = BasicCell<9>;
+
+    namespace detail {
+        /**
+         * @brief Compile-time shape of a board made of <code>BoxRows</code> x <code>BoxCols</code> boxes.
+         *
+         * <p>
+         * A board has <code>size = BoxRows * BoxCols</code> rows, columns, boxes
+         * and digits. Every loop bound and table size below derives from these
+         * constants, and the narrowest integer types that fit are selected, so the
+         * 9x9 board keeps 16-bit masks and 8-bit cell indices.
+         * </p>
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols>
+        struct Geometry {
+            static_assert(BoxRows >= 1 && BoxCols >= 1, "boxes need at least one row and column");
+
+            static constexpr uint8_t box_rows = BoxRows;
+            static constexpr uint8_t box_cols = BoxCols;
+            static constexpr uint8_t size = BoxRows * BoxCols;                      ///< Cells per unit and digits
+            static constexpr uint16_t cell_count = uint16_t{size} * size;           ///< Cells of the board
+
+            using cell_type = BasicCell<size>;
+            using mask_type = typename cell_type::mask_type;
+            /// Cell index; also wide enough to count every cell
+            using index_type = typename std::conditional<(cell_count < 256), std::uint8_t, std::uint16_t>::type;
+            /// Cell index or a negative marker (solved / contradiction)
+            using signed_index = typename std::conditional<(cell_count < 128), std::int8_t, std::int16_t>::type;
+
+            static constexpr mask_type full_mask = cell_type::full_mask;
+        };
+    }
+
     // =========================
-    //   SUDOKU BOARD
+    //   UNDO TRAIL
     // =========================
 
     /**
-     * @brief Main board class representing a 9x9 Sudoku puzzle.
+     * @brief One recorded cell change: the state a cell had before it was written.
      */
-    struct Board {
-        array<SudokuCell, 81> cells;
+    template<uint8_t BoxRows, uint8_t BoxCols>
+    struct BasicUndoEntry {
+        typename detail::Geometry<BoxRows, BoxCols>::mask_type state; ///< Previous cell state
+        typename detail::Geometry<BoxRows, BoxCols>::index_type idx;  ///< Index of the cell in <code>Board::cells</code>
+    };
 
-        SudokuCell &at(const uint8_t r, const uint8_t c) { return cells[r * 9 + c]; }
+    using UndoEntry = BasicUndoEntry<3, 3>;
 
-        [[nodiscard]] const SudokuCell &at(const uint8_t r, const uint8_t c) const { return cells[r * 9 + c]; }
+    namespace detail {
+        /**
+         * @brief Recorder that keeps no history; used when every frame owns a board copy.
+         */
+        struct NoTrail {
+            template<typename Cell>
+            SD_CONSTEXPR20 void save(const Cell &) const noexcept {
+            }
+        };
 
-        const array<SudokuCell *, 9> get_row(const uint8_t r) {
-            return {
-                    &at(r, 0), &at(r, 1), &at(r, 2), &at(r, 3), &at(r, 4),
-                    &at(r, 5), &at(r, 6), &at(r, 7), &at(r, 8)
-            };
-        }
+        /**
+         * @brief Recorder that pushes the previous state of every written cell on an undo trail.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols>
+        struct BasicTrailRecorder {
+            using geometry = Geometry<BoxRows, BoxCols>;
 
-        const array<SudokuCell *, 9> get_col(const uint8_t c) {
-            return {
-                    &at(0, c), &at(1, c), &at(2, c), &at(3, c), &at(4, c),
-                    &at(5, c), &at(6, c), &at(7, c), &at(8, c)
-            };
-        }
+            const typename geometry::cell_type *base;    ///< First cell of the board being changed in place
+            BasicUndoEntry<BoxRows, BoxCols> *entries;   ///< Trail storage
+            std::uint16_t size;                          ///< Number of recorded entries
 
-        const array<SudokuCell *, 9> get_box(const uint8_t b) {
-            const uint8_t sr = b / 3 * 3;
-            const uint8_t sc = b % 3 * 3;
-            return {
-                    &at(sr, sc), &at(sr, sc + 1), &at(sr, sc + 2),
-                    &at(sr + 1, sc), &at(sr + 1, sc + 1), &at(sr + 1, sc + 2),
-                    &at(sr + 2, sc), &at(sr + 2, sc + 1), &at(sr + 2, sc + 2)
-            };
-        }
+            SD_CONSTEXPR20 void save(const typename geometry::cell_type &cell) noexcept {
+                entries[size++] = {cell.state, static_cast<typename geometry::index_type>(&cell - base)};
+            }
+        };
 
-        static bool deduce_group(const array<SudokuCell *, 9> group) {
-            uint16_t confirmedMask = 0b1;
-            bool changed = false;
-            for (const auto *cell: group)
-                if (cell->isConfirmed()) confirmedMask |= cell->possibleMask();
+        using TrailRecorder = BasicTrailRecorder<3, 3>;
+    }
 
-            for (auto *cell: group) {
-                if (!cell->isConfirmed()) {
-                    const uint16_t mask = cell->possibleMask() & ~confirmedMask;
-                    if (mask == 0) return false;
-                    if ((mask & mask - 1) == 0) {  // ensure single-bit
-                        cell->state = mask | 0b1;
-                        confirmedMask |= mask;
-                        changed = true;
-                    } else if (mask != cell->possibleMask()) {
-                        cell->state = mask;
-                        changed = true;
-                    }
-                }
-            }
-            return changed;
-        }
+    // =========================
+    //   UNIT / PEER TABLES
+    // =========================
 
-        bool deduce_once() {
-            bool changed = false;
-            for (uint8_t i = 0; i < 9; ++i) {
-                changed |= deduce_group(get_row(i));
-                changed |= deduce_group(get_col(i));
-                changed |= deduce_group(get_box(i));
-            }
-            return changed;
+    /**
+     * @brief Unit-set policy of the classic board: rows, columns and boxes.
+     *
+     * <p>
+     * The third template parameter of <code>BasicBoard</code> says which groups
+     * of cells take distinct digits. Variants derive from this policy and
+     * override what differs: <code>region()</code> replaces the boxes by
+     * irregular regions (jigsaw), <code>diagonals</code> adds both main
+     * diagonals as units (X-Sudoku), and <code>cage_count</code>,
+     * <code>cage_of()</code> and <code>cage_sum()</code> add killer cages
+     * (distinct digits with a given sum). The policy is only read at compile
+     * time, into the board's <code>detail::UnitTables</code>.
+     * </p>
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols>
+    struct StandardUnits {
+        static constexpr uint8_t no_cage = 0xFF;
+        static constexpr bool diagonals = false;  ///< Both main diagonals hold every digit once
+        static constexpr uint8_t cage_count = 0;  ///< Killer cages
+
+        /// Region of a cell (0..size-1); every region must have <code>size</code> cells
+        static constexpr uint8_t region(const uint16_t cell) {
+            const uint16_t r = cell / (BoxRows * BoxCols), c = cell % (BoxRows * BoxCols);
+            return static_cast<uint8_t>(r / BoxRows * BoxRows + c / BoxCols);
         }
 
-        bool deduce_full() {
-            while (deduce_once()) {
-            }
-            for (auto &c: cells) if (!c.isValid()) return false; // NOLINT for range-based for
-            return true;
-        }
+        /// Cage of a cell, or <code>no_cage</code>; a cage holds at most <code>size</code> cells
+        static constexpr uint8_t cage_of(const uint16_t) { return no_cage; }
 
-        [[nodiscard]] bool is_solved() const {
-            for (const auto &c: cells) // NOLINT for range-based for
-                if (!c.isConfirmed()) return false;
-            return true;
-        }
+        /// Sum of the digits of a cage
+        static constexpr uint16_t cage_sum(const uint8_t) { return 0; }
+    };
 
-        void print() const {
-            for (uint8_t r = 0; r < 9; ++r) {
-                for (uint8_t c = 0; c < 9; ++c) {
-                    const uint8_t v = at(r, c).getConfirmedValue();
-                    std::cout << (v ? static_cast<char>('0' + v) : '.') << ' ';
-                }
-                std::cout << '\n';
+    /**
+     * @brief Unit-set policy of X-Sudoku: the classic units plus both main diagonals.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols>
+    struct DiagonalUnits : StandardUnits<BoxRows, BoxCols> {
+        static constexpr bool diagonals = true;
+    };
+
+    namespace detail {
+        /**
+         * @brief Every region has <code>Size</code> cells and every cage 1 to <code>Size</code>.
+         */
+        template<typename Units, uint8_t Size>
+        constexpr bool valid_units() {
+            uint16_t region_cells[Size] = {}, cage_cells[Units::cage_count + 1] = {};
+            for (uint16_t idx = 0; idx < uint16_t{Size} * Size; ++idx) {
+                const uint8_t region = Units::region(idx);
+                if (region >= Size) return false;
+                ++region_cells[region];
+                const uint8_t cage = Units::cage_of(idx);
+                if (cage == Units::no_cage) continue;
+                if (cage >= Units::cage_count) return false;
+                ++cage_cells[cage];
             }
+            for (const uint16_t count: region_cells) if (count != Size) return false; // NOLINT for range-based for
+            for (uint8_t cage = 0; cage < Units::cage_count; ++cage)
+                if (cage_cells[cage] == 0 || cage_cells[cage] > Size) return false;
+            return true;
         }
 
-        void load(const char *str) {
-            for (uint8_t i = 0; i < 81; ++i) {
-                const char ch = str[i]; // NOLINT for inplace-if
-                if (ch >= '1' && ch <= '9')
-                    cells[i].state = 0b1 | 1 << (ch - '0'); // NOLINT for parentheses
-                else
-                    cells[i].state = 0b1111111110;
+        /**
+         * @brief The units of every cell and the cells of every unit, straight from a unit-set policy.
+         */
+        template<typename Units, uint8_t Size>
+        struct Membership {
+            static constexpr uint16_t cell_count = uint16_t{Size} * Size;
+            static constexpr uint8_t full_unit_count = 3 * Size + (Units::diagonals ? 2 : 0);
+            static constexpr uint8_t unit_count = full_unit_count + Units::cage_count;
+
+            uint16_t cells[unit_count][Size];    ///< Cells of each unit in row-major order
+            uint8_t length[unit_count];          ///< Cells listed in <code>cells</code>
+            uint8_t units[cell_count][6];        ///< Row, column, region, then diagonals and cage
+            uint8_t unit_total[cell_count];      ///< Units listed in <code>units</code>
+        };
+
+        template<typename Units, uint8_t Size>
+        constexpr Membership<Units, Size> make_membership() {
+            using membership = Membership<Units, Size>;
+            membership m{};
+            for (uint16_t idx = 0; idx < membership::cell_count; ++idx) {
+                const uint16_t r = idx / Size, c = idx % Size;
+                uint8_t *units = m.units[idx];
+                uint8_t &k = m.unit_total[idx];
+                units[k++] = static_cast<uint8_t>(r);
+                units[k++] = static_cast<uint8_t>(Size + c);
+                units[k++] = static_cast<uint8_t>(2 * Size + Units::region(idx) % Size);
+                if (Units::diagonals && r == c) units[k++] = 3 * Size;
+                if (Units::diagonals && r + c == Size - 1) units[k++] = 3 * Size + 1;
+                const uint8_t cage = Units::cage_of(idx);
+                if (Units::cage_count && cage < Units::cage_count) units[k++] = membership::full_unit_count + cage;
+                for (uint8_t i = 0; i < k; ++i)
+                    if (m.length[units[i]] < Size) m.cells[units[i]][m.length[units[i]]++] = idx; // oversized regions fail valid_units()
             }
+            return m;
         }
 
-        void load_int8_t(const int8_t *arr) {
-            for (uint8_t i = 0; i < 81; ++i) {
-                const int8_t ch = arr[i]; // NOLINT for inplace-if
-                if (ch >= 1 && ch <= 9)
-                    cells[i].state = 0b1 | 1 << ch; // NOLINT for parentheses
-                else
-                    cells[i].state = 0b1111111110;
+        /**
+         * @brief Peers of the cell that has the most under a unit-set policy.
+         */
+        template<typename Units, uint8_t Size>
+        constexpr uint8_t max_peers() {
+            const Membership<Units, Size> m = make_membership<Units, Size>();
+            uint16_t stamp[Membership<Units, Size>::cell_count] = {};
+            uint16_t most = 0;
+            for (uint16_t idx = 0; idx < Membership<Units, Size>::cell_count; ++idx) {
+                uint16_t count = 0;
+                stamp[idx] = static_cast<uint16_t>(idx + 1);
+                for (uint8_t k = 0; k < m.unit_total[idx]; ++k) {
+                    const uint8_t unit = m.units[idx][k];
+                    for (uint8_t i = 0; i < m.length[unit]; ++i) {
+                        const uint16_t other = m.cells[unit][i];
+                        if (stamp[other] == idx + 1) continue;
+                        stamp[other] = static_cast<uint16_t>(idx + 1);
+                        ++count;
+                    }
+                }
+                if (count > most) most = count;
             }
+            return static_cast<uint8_t>(most);
         }
 
-        int8_t inner_solve() {
-            if (!deduce_full()) return -2;
+        /**
+         * @brief Geometry of a board together with the unit counts of its unit-set policy.
+         *
+         * <p>
+         * Units are numbered rows <code>0..size-1</code>, columns
+         * <code>size..2*size-1</code>, regions after that, then the main and
+         * anti-diagonal and finally the cages. The first
+         * <code>full_unit_count</code> units hold every digit exactly once.
+         * </p>
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        struct Layout : Geometry<BoxRows, BoxCols> {
+            using units_policy = Units;
+            using base = Geometry<BoxRows, BoxCols>;
 
-            if (is_solved()) return -1;
+            static_assert(3 * base::size + 2 + Units::cage_count <= 0xFF, "unit indices are 8-bit");
+            static_assert(valid_units<Units, base::size>(), "every region needs exactly size cells and every cage 1 to size cells");
 
-            uint8_t min_choices = 10;
-            int8_t target_idx = -2;
+            static constexpr uint8_t full_unit_count = Membership<Units, base::size>::full_unit_count;
+            static constexpr uint8_t unit_count = Membership<Units, base::size>::unit_count;
+            /// Units of every cell, padded with its row where a cell has fewer
+            static constexpr uint8_t units_per_cell = 3 + (Units::diagonals ? 2 : 0) + (Units::cage_count ? 1 : 0);
 
-            for (int8_t i = 0; i < 81; ++i) {
-                if (!cells[i].isConfirmed()) {
-                    auto count = detail::popcount16(cells[i].possibleMask()); // NOLINT for inplace-if
-                    if (count < min_choices) {
-                        min_choices = count;
-                        target_idx = i;
-                    }
-                }
-            }
+            /// Peers of the cell with the most; cells with fewer pad their list
+            static constexpr uint8_t peer_count = max_peers<Units, base::size>();
+        };
 
-            return target_idx;
-        }
+        /**
+         * @brief Cell-index tables for the units of a board.
+         *
+         * <p>
+         * Units are numbered as in <code>Layout</code> (for the classic 9x9
+         * board: rows 0–8, columns 9–17, boxes 18–26); regions are numbered as
+         * the policy's <code>region()</code> returns them and every unit lists its
+         * cells in row-major order. Every table entry is an index into
+         * <code>Board::cells</code>.
+         * </p>
+         */
+        template<typename L>
+        struct UnitTables {
+            using index_type = typename L::index_type;
+
+            index_type units[L::unit_count][L::size];        ///< Cells of each unit; a cage repeats its first cell after its last
+            std::uint8_t unit_length[L::unit_count];         ///< Cells of each unit: <code>size</code>, or fewer for a cage
+            std::uint16_t unit_sum[L::unit_count];           ///< Digit sum of each cage; 0 for the other units
+            index_type peers[L::cell_count][L::peer_count];  ///< The cells sharing a unit with each cell, padded with the first
+            std::uint8_t cell_units[L::cell_count][L::units_per_cell]; ///< Row, column and region, then diagonals and cage
+        };
 
-        [[nodiscard]] bool check_initial_valid() {
-            for (uint8_t i = 0; i < 9; ++i) {
-                if (!check_unit(get_row(i))) return false;
-                if (!check_unit(get_col(i))) return false;
-                if (!check_unit(get_box(i))) return false;
+        template<typename L>
+        constexpr UnitTables<L> make_unit_tables() {
+            using index_type = typename L::index_type;
+            using units_policy = typename L::units_policy;
+            constexpr uint8_t n = L::size;
+            const Membership<units_policy, n> m = make_membership<units_policy, n>();
+
+            UnitTables<L> t{};
+            for (uint8_t u = 0; u < L::unit_count; ++u) {
+                t.unit_length[u] = m.length[u];
+                for (uint8_t i = 0; i < n; ++i) t.units[u][i] = static_cast<index_type>(m.cells[u][i < m.length[u] ? i : 0]);
+                if (u >= L::full_unit_count)
+                    t.unit_sum[u] = units_policy::cage_sum(static_cast<uint8_t>(u - L::full_unit_count));
             }
-            return true;
-        }
 
-        static bool check_unit(const array<SudokuCell *, 9> &group) {
-            uint16_t confirmed = 0b0;
-            for (const auto *cell: group) {
-                if (cell->isConfirmed()) {
-                    const uint16_t mask = cell->possibleMask();
-                    if ((confirmed & mask) != 0) return false; // duplicate
-                    confirmed |= mask;
+            uint16_t stamp[L::cell_count] = {};
+            for (uint16_t idx = 0; idx < L::cell_count; ++idx) {
+                for (uint8_t k = 0; k < L::units_per_cell; ++k)
+                    t.cell_units[idx][k] = m.units[idx][k < m.unit_total[idx] ? k : 0];
+
+                // Peers in increasing cell order
+                stamp[idx] = static_cast<uint16_t>(idx + 1);
+                uint8_t count = 0;
+                for (uint8_t k = 0; k < m.unit_total[idx]; ++k) {
+                    const uint8_t unit = m.units[idx][k];
+                    for (uint8_t i = 0; i < m.length[unit]; ++i) {
+                        const uint16_t other = m.cells[unit][i];
+                        if (stamp[other] == idx + 1) continue;
+                        stamp[other] = static_cast<uint16_t>(idx + 1);
+                        ++count;
+                    }
                 }
+                uint8_t k = 0;
+                for (uint16_t other = 0; other < L::cell_count && k < count; ++other)
+                    if (other != idx && stamp[other] == idx + 1) t.peers[idx][k++] = static_cast<index_type>(other);
+                for (uint8_t i = k; i < L::peer_count; ++i) t.peers[idx][i] = t.peers[idx][0];
             }
-            return true;
+            return t;
         }
-    };
 
-    // =========================
-    //   BACKTRACKING SOLVER
-    // =========================
+        template<typename L>
+        inline constexpr UnitTables<L> basic_unit_tables = make_unit_tables<L>();
 
-    /**
-     * @brief Internal stack frame for iterative backtracking.
-     */
-    struct Frame {
-        Board board{};
-        uint16_t remaining_mask{};
-        uint8_t target_idx{};
-    };
+        /// Layout of the classic 9x9 board
+        using classic_layout = Layout<3, 3, StandardUnits<3, 3>>;
 
+        /// Tables of the classic 9x9 board
+        inline constexpr const UnitTables<classic_layout> &unit_tables = basic_unit_tables<classic_layout>;
 
-    /**
-     * @brief Solve the given Sudoku board using iterative backtracking.
-     * @param root Board to solve (in-place).
-     * @return true if solved, false otherwise.
-     */
-    static bool solve(Board &root) {
-        const auto raw_stack = std::make_unique<uint8_t[]>(81 * sizeof(Frame)); // Maximum 81 frames
-        auto stack = reinterpret_cast<Frame *>(raw_stack.get()); // Avoid initializing unused stack frames
-        int8_t top = 0;
+        static_assert(classic_layout::unit_count == 27 && classic_layout::units_per_cell == 3,
+                      "the classic board keeps 27 units and three units per cell");
+        static_assert(classic_layout::peer_count == 20, "every cell has exactly 20 peers");
+        static_assert(unit_tables.units[26][8] == 80, "box table must end on the last cell");
+        static_assert(unit_tables.peers[80][19] == 79, "every cell has exactly 20 peers");
 
-        const int8_t result = root.inner_solve();
-        if (result == -1) return true; // already solved
-        if (result == -2) return false; // invalid
+        /**
+         * @brief Bit set over the units of a board: one machine word when it fits.
+         */
+        template<uint8_t Bits, bool Wide = (Bits > 64)>
+        struct UnitSet {
+            using word = typename std::conditional<(Bits <= 32), std::uint32_t, std::uint64_t>::type;
+            word bits = 0;
+
+            [[nodiscard]] SD_CONSTEXPR20 bool test(const uint8_t i) const noexcept { return bits >> i & 1u; }
+            SD_CONSTEXPR20 void set(const uint8_t i) noexcept { bits |= word{1} << i; }
+            SD_CONSTEXPR20 void reset(const uint8_t i) noexcept { bits &= ~(word{1} << i); }
+            [[nodiscard]] SD_CONSTEXPR20 bool none() const noexcept { return bits == 0; }
+        };
 
-        stack[0].board = root;
-        stack[0].target_idx = static_cast<uint8_t>(result);
-        stack[0].remaining_mask = root.cells[result].possibleMask();
+        template<uint8_t Bits>
+        struct UnitSet<Bits, true> {
+            std::uint64_t words[(Bits + 63) / 64] = {};
 
-        while (top >= 0) {
-            Frame &frame = stack[top]; // NOLINT for object auto-unpacking
-            const uint16_t mask = frame.remaining_mask;
+            [[nodiscard]] SD_CONSTEXPR20 bool test(const uint8_t i) const noexcept { return words[i >> 6] >> (i & 63) & 1u; }
+            SD_CONSTEXPR20 void set(const uint8_t i) noexcept { words[i >> 6] |= std::uint64_t{1} << (i & 63); }
+            SD_CONSTEXPR20 void reset(const uint8_t i) noexcept { words[i >> 6] &= ~(std::uint64_t{1} << (i & 63)); }
 
-            if (mask == 0) {
-                --top; // no mask, backtrack
-                continue;
+            [[nodiscard]] SD_CONSTEXPR20 bool none() const noexcept {
+                std::uint64_t any = 0;
+                for (const std::uint64_t w: words) any |= w; // NOLINT for range-based for
+                return any == 0;
             }
+        };
 
-            // Lowest mask
-            const uint16_t pick = mask & -mask;
-            frame.remaining_mask ^= pick;
+        /// Smallest power of two holding <code>n</code> entries
+        constexpr uint16_t ring_capacity(const uint16_t n) {
+            uint16_t capacity = 1;
+            while (capacity < n) capacity = static_cast<uint16_t>(capacity * 2);
+            return capacity;
+        }
+    }
 
-            Board next = frame.board;
-            next.cells[frame.target_idx].state = pick | 0b1;
+    /**
+     * @brief How much reasoning incremental propagation applies per unit.
+     *
+     * <p>
+     * Higher levels cost more per search node but usually leave far fewer nodes
+     * to search.
+     * </p>
+     */
+    enum class DeductionLevel : uint8_t {
+        naked_singles,  ///< Peer elimination only; a cell with one candidate is confirmed
+        hidden_singles, ///< Also place a digit that has one possible cell left in a unit
+        pairs           ///< Also apply naked pairs and hidden pairs
+    };
 
-            const int8_t res = next.inner_solve();
-            if (res == -1) {
-                root = next;
-                return true;
+    namespace detail {
+        /**
+         * @brief Fixed-size event queues for incremental propagation.
+         *
+         * <p>
+         * A cell enters <code>cells</code> once, when it becomes confirmed, so one
+         * slot per cell always suffices. A unit is queued at most once at a time,
+         * tracked by the <code>queued</code> set, so a ring of the next power of two
+         * above the unit count (32 for 9x9) never overflows.
+         * </p>
+         */
+        template<typename G>
+        struct Worklist {
+            using index_type = typename G::index_type;
+            static constexpr uint16_t ring = ring_capacity(G::unit_count);
+
+            index_type cells[G::cell_count];  ///< Confirmed cells whose digit must still leave their peers
+            std::uint8_t units[ring];         ///< Ring of units whose candidates shrank
+            UnitSet<G::unit_count> queued{};  ///< Unit u is in the set while it is in the ring
+            index_type cell_head = 0, cell_tail = 0;
+            std::uint8_t unit_head = 0, unit_tail = 0;
+            DeductionLevel level;             ///< Rules applied to each dequeued unit
+
+            explicit SD_CONSTEXPR20 Worklist(const DeductionLevel lvl) noexcept : level(lvl) {
             }
-            if (!next.check_initial_valid()) {
-                --top; // The previous state is invalid which leads to this state
-                continue;
-            } // Only check if I took a guess
-            if (res == -2) continue;
 
-            ++top;
-            stack[top].board = next;
-            stack[top].target_idx = res;
-            stack[top].remaining_mask = next.cells[res].possibleMask();
-        }
+            SD_CONSTEXPR20 void push_cell(const index_type idx) noexcept { cells[cell_tail++] = idx; }
 
-        return false;
+            SD_CONSTEXPR20 void push_unit(const std::uint8_t unit) noexcept {
+                if (queued.test(unit)) return;
+                queued.set(unit);
+                units[unit_tail++ & (ring - 1)] = unit;
+            }
+
+            SD_CONSTEXPR20 std::uint8_t pop_unit() noexcept {
+                const std::uint8_t unit = units[unit_head++ & (ring - 1)];
+                queued.reset(unit);
+                return unit;
+            }
+        };
+    }
+
+    // =========================
+    //   SUDOKU BOARD
+    // =========================
+
+    /**
+     * @brief Board of <code>BoxRows</code> x <code>BoxCols</code> boxes: 9x9 for 3x3, 16x16 for 4x4, 25x25 for 5x5.
+     *
+     * <p>
+     * Besides the cells, the board tracks which digits are confirmed in every
+     * unit and how many cells are confirmed, so the search can test placements
+     * and completion in O(1). These summaries are rebuilt by <code>load()</code>,
+     * <code>load_int8_t()</code>, <code>sync_placement()</code> and
+     * <code>propagate_all()</code>, and kept current by <code>place()</code>;
+     * code that writes <code>cells</code> directly must resynchronize.
+     * </p>
+     *
+     * <p>
+     * All dimensions are compile-time constants of the instantiation; the
+     * classic board is the alias <code>sd::Board</code>.
+     * </p>
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units = StandardUnits<BoxRows, BoxCols>>
+    struct SD_CACHE_ALIGN BasicBoard {
+        using geometry = detail::Layout<BoxRows, BoxCols, Units>;
+        using cell_type = typename geometry::cell_type;
+        using mask_type = typename geometry::mask_type;
+        using index_type = typename geometry::index_type;
+        using signed_index = typename geometry::signed_index;
+        using undo_entry = BasicUndoEntry<BoxRows, BoxCols>;
+        using worklist = detail::Worklist<geometry>;
+
+        static constexpr uint8_t size = geometry::size;
+        static constexpr uint16_t cell_count = geometry::cell_count;
+        static constexpr uint8_t unit_count = geometry::unit_count;
+        static constexpr uint8_t full_unit_count = geometry::full_unit_count;
+        static constexpr uint8_t units_per_cell = geometry::units_per_cell;
+        static constexpr uint8_t peer_count = geometry::peer_count;
+        static constexpr mask_type full_mask = geometry::full_mask;
+
+        array<cell_type, cell_count> cells;
+        mask_type unit_digits[unit_count]; ///< Digits confirmed in each unit (bits 1–size), indexed as in detail::UnitTables
+        index_type confirmed_count;        ///< Number of confirmed cells
+
+        static constexpr const detail::UnitTables<geometry> &tables() noexcept {
+            return detail::basic_unit_tables<geometry>;
+        }
+
+        /**
+         * @brief Cells of a unit: <code>size</code>, except for killer cages.
+         */
+        static constexpr uint8_t unit_length(const uint8_t unit) noexcept {
+            if constexpr (Units::cage_count == 0) return size;
+            else return unit < full_unit_count ? size : tables().unit_length[unit];
+        }
+
+        SD_CONSTEXPR20 cell_type &at(const uint8_t r, const uint8_t c) { return cells[r * size + c]; }
+
+        [[nodiscard]] SD_CONSTEXPR20 const cell_type &at(const uint8_t r, const uint8_t c) const { return cells[r * size + c]; }
+
+        SD_CONSTEXPR20 const array<cell_type *, size> get_row(const uint8_t r) { return get_unit(r); }
+
+        SD_CONSTEXPR20 const array<cell_type *, size> get_col(const uint8_t c) { return get_unit(size + c); }
+
+        SD_CONSTEXPR20 const array<cell_type *, size> get_box(const uint8_t b) { return get_unit(2 * size + b); }
+
+        SD_CONSTEXPR20 const array<cell_type *, size> get_unit(const uint8_t unit) {
+            array<cell_type *, size> group{};
+            for (uint8_t i = 0; i < size; ++i) group[i] = &cells[tables().units[unit][i]];
+            return group;
+        }
+
+        /**
+         * @brief Apply naked singles to one unit (see <code>detail::UnitTables</code>).
+         * @return true if any cell of the unit changed.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool deduce_group(const uint8_t unit, Trail &trail) {
+            const index_type *group = tables().units[unit];
+            const uint8_t length = unit_length(unit);
+            mask_type confirmedMask = 0b1;
+            bool changed = false;
+            for (uint8_t i = 0; i < length; ++i) {
+                const cell_type &cell = cells[group[i]];
+                if (cell.isConfirmed()) confirmedMask |= cell.possibleMask();
+            }
+
+            for (uint8_t i = 0; i < length; ++i) {
+                cell_type &cell = cells[group[i]];
+                if (!cell.isConfirmed()) {
+                    const mask_type mask = cell.possibleMask() & ~confirmedMask;
+                    if (mask == 0) return false;
+                    if ((mask & mask - 1) == 0) {  // ensure single-bit
+                        trail.save(cell);
+                        cell.state = mask | 0b1;
+                        confirmedMask |= mask;
+                        changed = true;
+                    } else if (mask != cell.possibleMask()) {
+                        trail.save(cell);
+                        cell.state = mask;
+                        changed = true;
+                    }
+                }
+            }
+            return changed;
+        }
+
+        SD_CONSTEXPR20 bool deduce_once() {
+            detail::NoTrail trail;
+            return deduce_once(trail);
+        }
+
+        template<typename Trail>
+        SD_CONSTEXPR20 bool deduce_once(Trail &trail) {
+#if SD_SIMD != SD_SIMD_NONE
+            // Without an undo trail every cell can be rewritten at once
+            if constexpr (std::is_same<Trail, detail::NoTrail>::value && std::is_same<geometry, detail::classic_layout>::value)
+                if (!detail::is_constant_evaluated()) return deduce_sweep();
+#endif
+            bool changed = false;
+            for (uint8_t u = 0; u < unit_count; ++u)
+                changed |= deduce_group(u, trail);
+            return changed;
+        }
+
+#if SD_SIMD != SD_SIMD_NONE
+        /**
+         * @brief Vectorised naked-single pass over all 27 units at once (9x9 only).
+         *
+         * <p>
+         * Row <i>r</i> is held as one 8-lane vector (columns 0–7) plus a scalar
+         * lane for column 8. Column masks are a vertical OR of the rows, row and box
+         * masks are horizontal ORs, and the eliminated candidates are removed from
+         * every undecided cell with a single AND-NOT. Unlike the scalar pass, all
+         * cells are updated from the same snapshot; the fixpoint reached by
+         * <code>deduce_full()</code> is identical. An emptied cell is written as 0
+         * so that <code>deduce_full()</code> and <code>propagate_all()</code> report it.
+         * </p>
+         *
+         * @return true if any cell changed.
+         */
+        bool deduce_sweep() {
+            static_assert(std::is_same<geometry, detail::classic_layout>::value, "the SIMD sweep is laid out for classic 9x9 boards");
+            namespace v = detail::simd;
+            const v::vec one = v::splat(0b1), full = v::splat(0b1111111110), zero = v::splat(0);
+
+            v::vec rows[9], confirmed[9];
+            uint16_t last[9], last_confirmed[9];
+            v::vec col = zero;
+            uint16_t col_last = 0;
+            for (uint8_t r = 0; r < 9; ++r) {
+                rows[r] = v::load(&cells[r * 9].state);
+                confirmed[r] = v::bit_and(v::equal(v::bit_and(rows[r], one), one), v::bit_and(rows[r], full));
+                col = v::bit_or(col, confirmed[r]);
+                last[r] = cells[r * 9 + 8].state;
+                last_confirmed[r] = (last[r] & 0b1) ? static_cast<uint16_t>(last[r] & 0b1111111110) : 0;
+                col_last |= last_confirmed[r];
+            }
+
+            bool changed = false;
+            for (uint8_t band = 0; band < 3; ++band) {
+                uint16_t stack[8];
+                v::store(stack, v::bit_or(v::bit_or(confirmed[band * 3], confirmed[band * 3 + 1]),
+                                          confirmed[band * 3 + 2]));
+                const uint16_t stack_last = last_confirmed[band * 3] | last_confirmed[band * 3 + 1] |
+                                            last_confirmed[band * 3 + 2];
+                const uint16_t b0 = stack[0] | stack[1] | stack[2];
+                const uint16_t b1 = stack[3] | stack[4] | stack[5];
+                const uint16_t b2 = stack[6] | stack[7] | stack_last;
+                const v::vec box = v::bit_or(v::bit_and(v::splat(b0), v::load(detail::simd_box_lanes[0])),
+                                             v::bit_or(v::bit_and(v::splat(b1), v::load(detail::simd_box_lanes[1])),
+                                                       v::bit_and(v::splat(b2), v::load(detail::simd_box_lanes[2]))));
+
+                for (uint8_t r = band * 3; r < band * 3 + 3; ++r) {
+                    const uint16_t row = v::reduce_or(confirmed[r]) | last_confirmed[r];
+                    const v::vec elim = v::bit_or(v::bit_or(col, box), v::splat(row));
+
+                    // Undecided lanes lose eliminated digits; a lone survivor is confirmed
+                    const v::vec undecided = v::equal(v::bit_and(rows[r], one), zero);
+                    const v::vec mask = v::and_not(rows[r], elim);
+                    const v::vec single = v::equal(v::bit_and(mask, v::sub(mask, one)), zero);
+                    const v::vec reduced = v::select(single, v::bit_or(mask, v::and_not(one, v::equal(mask, zero))), mask);
+                    const v::vec next = v::select(undecided, reduced, rows[r]);
+                    if (v::any(v::and_not(v::splat(0xFFFF), v::equal(next, rows[r])))) {
+                        v::store(&cells[r * 9].state, next);
+                        changed = true;
+                    }
+
+                    if (!(last[r] & 0b1)) {
+                        const uint16_t m = last[r] & ~(col_last | b2 | row);
+                        const uint16_t n = (m && (m & (m - 1)) == 0) ? static_cast<uint16_t>(m | 0b1) : m;
+                        if (n != last[r]) {
+                            cells[r * 9 + 8].state = n;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+            return changed;
+        }
+#endif
+
+        SD_CONSTEXPR20 bool deduce_full() {
+            detail::NoTrail trail;
+            return deduce_full(trail);
+        }
+
+        template<typename Trail>
+        SD_CONSTEXPR20 bool deduce_full(Trail &trail) {
+            while (deduce_once(trail)) {
+            }
+            for (auto &c: cells) if (!c.isValid()) return false; // NOLINT for range-based for
+            return true;
+        }
+
+        [[nodiscard]] SD_CONSTEXPR20 bool is_solved() const {
+            for (const auto &c: cells) // NOLINT for range-based for
+                if (!c.isConfirmed()) return false;
+            return true;
+        }
+
+        /**
+         * @brief Text digit of a value: '1'–'9', then 'A' for 10, 'B' for 11, ...; '.' for none.
+         */
+        static SD_CONSTEXPR20 char digit_char(const uint8_t v) {
+            if (v == 0) return '.';
+            return static_cast<char>(v <= 9 ? '0' + v : 'A' + (v - 10));
+        }
+
+        /**
+         * @brief Inverse of <code>digit_char()</code> (letters in either case); 0 for an empty cell.
+         */
+        static SD_CONSTEXPR20 uint8_t char_digit(const char ch) {
+            uint8_t v = 0;
+            if (ch >= '1' && ch <= '9') v = static_cast<uint8_t>(ch - '0');
+            else if (ch >= 'A' && ch <= 'Z') v = static_cast<uint8_t>(ch - 'A' + 10);
+            else if (ch >= 'a' && ch <= 'z') v = static_cast<uint8_t>(ch - 'a' + 10);
+            return v <= size ? v : 0;
+        }
+
+        void print() const {
+            for (uint8_t r = 0; r < size; ++r) {
+                for (uint8_t c = 0; c < size; ++c) {
+                    std::cout << digit_char(static_cast<uint8_t>(at(r, c).getConfirmedValue())) << ' ';
+                }
+                std::cout << '\n';
+            }
+        }
+
+        /**
+         * @brief Load <code>cell_count</code> characters in the format of <code>char_digit()</code>.
+         */
+        SD_CONSTEXPR20 void load(const char *str) {
+            for (index_type i = 0; i < cell_count; ++i) {
+                const uint8_t v = char_digit(str[i]); // NOLINT for inplace-if
+                if (v)
+                    cells[i].state = static_cast<mask_type>(0b1 | mask_type{1} << v);
+                else
+                    cells[i].state = full_mask;
+            }
+            sync_placement();
+        }
+
+        SD_CONSTEXPR20 void load_int8_t(const int8_t *arr) {
+            for (index_type i = 0; i < cell_count; ++i) {
+                const int8_t ch = arr[i]; // NOLINT for inplace-if
+                if (ch >= 1 && ch <= size)
+                    cells[i].state = static_cast<mask_type>(0b1 | mask_type{1} << ch);
+                else
+                    cells[i].state = full_mask;
+            }
+            sync_placement();
+        }
+
+        /**
+         * @brief Rebuild <code>unit_digits</code> and <code>confirmed_count</code> from the cells.
+         * @return false if a digit is confirmed twice in some unit.
+         */
+        SD_CONSTEXPR20 bool sync_placement() {
+            bool valid = true;
+            for (mask_type &digits: unit_digits) digits = 0; // NOLINT for range-based for
+            confirmed_count = 0;
+            for (index_type i = 0; i < cell_count; ++i) {
+                if (!cells[i].isConfirmed()) continue;
+                const mask_type bit = cells[i].possibleMask();
+                if (placed_around(i) & bit) valid = false;
+                for_each_unit(i, [this, bit](const uint8_t unit) { unit_digits[unit] |= bit; });
+                ++confirmed_count;
+            }
+            return valid;
+        }
+
+        /**
+         * @brief Restore one trail entry, keeping the placement summaries in step.
+         */
+        SD_CONSTEXPR20 void undo(const undo_entry &entry) {
+            cell_type &cell = cells[entry.idx];
+            if (cell.isConfirmed() && !(entry.state & 0b1)) {
+                const mask_type bit = cell.possibleMask();
+                for_each_unit(entry.idx, [this, bit](const uint8_t unit) { unit_digits[unit] &= ~bit; });
+                --confirmed_count;
+            }
+            cell.state = entry.state;
+        }
+
+        /**
+         * @brief Deduce as far as possible, then pick the next cell to branch on.
+         * @return -1 if solved, -2 if contradictory, otherwise the index of the
+         *         undecided cell with the fewest candidates.
+         */
+        SD_CONSTEXPR20 signed_index inner_solve() {
+            detail::NoTrail trail;
+            return inner_solve(trail);
+        }
+
+        template<typename Trail>
+        SD_CONSTEXPR20 signed_index inner_solve(Trail &trail) {
+            if (!deduce_full(trail)) return -2;
+            // Cells confirmed by different units in the same pass may collide
+            if (!sync_placement()) return -2;
+            return pick_branch();
+        }
+
+        /**
+         * @brief Pick the undecided cell with the fewest candidates.
+         * @return -1 if every cell is confirmed, otherwise the chosen cell index.
+         */
+        [[nodiscard]] SD_CONSTEXPR20 signed_index pick_branch() const {
+            if (confirmed_count == cell_count) return -1;
+
+            uint8_t min_choices = size + 1;
+            signed_index target_idx = -2;
+
+            for (signed_index i = 0; i < static_cast<signed_index>(cell_count); ++i) {
+                if (!cells[i].isConfirmed()) {
+                    auto count = detail::popcount(cells[i].possibleMask()); // NOLINT for inplace-if
+                    if (count < min_choices) {
+                        min_choices = count;
+                        target_idx = i;
+                    }
+                }
+            }
+
+            return target_idx;
+        }
+
+        // =========================
+        //   INCREMENTAL PROPAGATION
+        // =========================
+
+        /**
+         * @brief Confirm <code>digit_mask</code> in cell <code>idx</code> and propagate.
+         *
+         * <p>
+         * Only the consequences of the new digit are computed: it leaves the peers
+         * of the cell, peers reduced to one candidate are confirmed in turn, and only
+         * units that lost candidates are re-examined. Any contradiction (an emptied
+         * cell, a digit confirmed twice in a unit, or a digit with no place left in
+         * a unit) is reported as soon as it appears.
+         * </p>
+         *
+         * @param idx Cell index.
+         * @param digit_mask Single candidate bit (bits 1–size).
+         * @param trail Recorder for every changed cell.
+         * @param level Rules applied to the units that lost candidates.
+         * @return false if the board became contradictory; it is then left partially
+         *         updated and must be restored by the caller.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool place(const index_type idx, const mask_type digit_mask, Trail &trail,
+                                  const DeductionLevel level = DeductionLevel::hidden_singles) {
+            const cell_type &cell = cells[idx];
+            if (cell.isConfirmed()) return cell.possibleMask() == digit_mask;
+            if ((cell.state & digit_mask) == 0) return false;
+
+            worklist work(level);
+            return confirm(idx, digit_mask, work, trail) && propagate(work, trail);
+        }
+
+        SD_CONSTEXPR20 bool place(const index_type idx, const mask_type digit_mask) {
+            detail::NoTrail trail;
+            return place(idx, digit_mask, trail);
+        }
+
+        /**
+         * @brief Propagate every confirmed cell of an arbitrary board.
+         *
+         * <p>
+         * Equivalent to <code>deduce_full()</code> followed by
+         * <code>check_initial_valid()</code>, but driven by peer elimination.
+         * Unconfirmed cells already reduced to a single candidate are confirmed,
+         * and the placement summaries are rebuilt first. On SIMD builds of the
+         * classic board without an undo trail, <code>deduce_sweep()</code> first
+         * reaches the naked-single fixpoint for all cells at once. The worklist
+         * then only has the later rules left to apply.
+         * </p>
+         *
+         * @return false if the board is contradictory.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool propagate_all(Trail &trail, const DeductionLevel level = DeductionLevel::hidden_singles) {
+#if SD_SIMD != SD_SIMD_NONE
+            // Without an undo trail the naked-single fixpoint is reached a row at a time
+            if constexpr (std::is_same<Trail, detail::NoTrail>::value && std::is_same<geometry, detail::classic_layout>::value)
+                if (!detail::is_constant_evaluated())
+                    while (deduce_sweep()) {
+                    }
+#endif
+            worklist work(level);
+            if (!sync_placement()) return false;
+            for (index_type i = 0; i < cell_count; ++i) {
+                const cell_type &cell = cells[i];
+                if (!cell.isValid()) return false;
+                if (cell.isConfirmed()) {
+                    work.push_cell(i);
+                } else {
+                    const mask_type mask = cell.possibleMask();
+                    if ((mask & (mask - 1)) == 0 && !confirm(i, mask, work, trail)) return false;  // single-bit
+                }
+            }
+            for (uint8_t u = 0; u < unit_count; ++u) work.push_unit(u);
+            return propagate(work, trail);
+        }
+
+        SD_CONSTEXPR20 bool propagate_all() {
+            detail::NoTrail trail;
+            return propagate_all(trail);
+        }
+
+        /**
+         * @brief Drain the worklist: peer elimination first, then unit rules.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool propagate(worklist &work, Trail &trail) {
+            while (true) {
+                while (work.cell_head != work.cell_tail) {
+                    const index_type idx = work.cells[work.cell_head++];
+                    if (!eliminate_from_peers(idx, work, trail)) return false;
+                }
+                if (work.queued.none()) return true;
+                if (!deduce_unit(work.pop_unit(), work, trail)) return false;
+            }
+        }
+
+        /**
+         * @brief Digits already confirmed in any unit of cell <code>idx</code>.
+         */
+        [[nodiscard]] SD_CONSTEXPR20 mask_type placed_around(const index_type idx) const {
+            mask_type placed = 0;
+            for_each_unit(idx, [this, &placed](const uint8_t unit) { placed |= unit_digits[unit]; });
+            return placed;
+        }
+
+        /**
+         * @brief Call <code>f</code> with every unit of cell <code>idx</code>, unrolled at compile time.
+         */
+        template<typename F>
+        static SD_CONSTEXPR20 void for_each_unit(const index_type idx, F &&f) {
+            for_each_unit(tables().cell_units[idx], f, std::make_index_sequence<units_per_cell>{});
+        }
+
+        template<typename F, std::size_t... K>
+        static SD_CONSTEXPR20 void for_each_unit(const uint8_t *units, F &f, std::index_sequence<K...>) {
+            (f(units[K]), ...);
+        }
+
+        /**
+         * @brief Confirm digit <code>bit</code> in undecided cell <code>idx</code>.
+         *
+         * The unit summaries turn the duplicate check into one bit test.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool confirm(const index_type idx, const mask_type bit, worklist &work, Trail &trail) {
+            if (SD_UNLIKELY(placed_around(idx) & bit)) return false;
+            for_each_unit(idx, [this, bit](const uint8_t unit) { unit_digits[unit] |= bit; });
+            ++confirmed_count;
+
+            cell_type &cell = cells[idx];
+            trail.save(cell);
+            cell.state = bit | 0b1;
+            work.push_cell(idx);
+            for_each_unit(idx, [&work](const uint8_t unit) { work.push_unit(unit); });
+            return true;
+        }
+
+        /**
+         * @brief Narrow an undecided cell to <code>mask</code>, a strict subset of its candidates.
+         *
+         * Confirms the cell if one candidate is left and queues its units.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool restrict_cell(const index_type idx, const mask_type mask, worklist &work, Trail &trail) {
+            if (SD_UNLIKELY(mask == 0)) return false;
+            if ((mask & (mask - 1)) == 0) return confirm(idx, mask, work, trail);  // single-bit
+            cell_type &cell = cells[idx];
+            trail.save(cell);
+            cell.state = mask;
+            for_each_unit(idx, [&work](const uint8_t unit) { work.push_unit(unit); });
+            return true;
+        }
+
+        /**
+         * @brief Remove the digit of confirmed cell <code>idx</code> from its peers.
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool eliminate_from_peers(const index_type idx, worklist &work, Trail &trail) {
+            const mask_type bit = cells[idx].possibleMask();
+            const index_type *peers = tables().peers[idx];
+            for (uint8_t i = 0; i < peer_count; ++i) {
+                const index_type p = peers[i];
+                const cell_type &peer = cells[p];
+                if ((peer.state & bit) == 0) continue;
+                if (SD_UNLIKELY(peer.isConfirmed())) return false; // duplicate digit in a unit
+                if (!restrict_cell(p, peer.state & ~bit, work, trail)) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Apply the unit rules selected by <code>work.level</code> to one unit.
+         *
+         * <p>
+         * One pass accumulates <code>once</code> (digits seen in at least one cell)
+         * and <code>twice</code> (digits seen in at least two cells); a digit in
+         * <code>once &amp; ~twice</code> that is not yet confirmed is a hidden single.
+         * A digit missing from <code>once</code> has no place left: contradiction.
+         * </p>
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool deduce_unit(const uint8_t unit, worklist &work, Trail &trail) {
+            if constexpr (Units::cage_count != 0)
+                if (unit >= full_unit_count) return deduce_cage(unit, work, trail);
+            const index_type *group = tables().units[unit];
+            const mask_type confirmed = unit_digits[unit];
+            mask_type once = 0, twice = 0;
+            for (uint8_t i = 0; i < size; ++i) {
+                const mask_type state = cells[group[i]].state;
+                twice |= once & state;
+                once |= state;
+            }
+            if (SD_UNLIKELY((once & full_mask) != full_mask)) return false;
+            if (work.level == DeductionLevel::naked_singles) return true;
+
+            mask_type hidden = once & ~twice & ~confirmed & full_mask;
+            while (hidden) {
+                const mask_type bit = hidden & -hidden;
+                hidden ^= bit;
+                uint8_t i = 0;
+                while (i < size && (cells[group[i]].state & bit) == 0) ++i;
+                // The only cell holding this digit was already taken by another hidden single
+                if (SD_UNLIKELY(i == size || cells[group[i]].isConfirmed())) return false;
+                if (!restrict_cell(group[i], bit, work, trail)) return false;
+            }
+            if (work.level == DeductionLevel::pairs) return deduce_pairs(unit, work, trail);
+            return true;
+        }
+
+        /**
+         * @brief Naked pairs and hidden pairs inside one unit.
+         *
+         * <p>
+         * Naked pair: two undecided cells with the same two candidates own those
+         * digits, which leave the rest of the unit. Hidden pair: two digits that can
+         * only go in the same two cells, which then lose every other candidate.
+         * </p>
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool deduce_pairs(const uint8_t unit, worklist &work, Trail &trail) {
+            const index_type *group = tables().units[unit];
+
+            for (uint8_t i = 0; i < size; ++i) {
+                const mask_type pair = cells[group[i]].state;
+                if ((pair & 0b1) || detail::popcount(pair) != 2) continue;
+                for (uint8_t j = i + 1; j < size; ++j) {
+                    if (cells[group[j]].state != pair) continue;
+                    for (uint8_t k = 0; k < size; ++k) {
+                        const cell_type &cell = cells[group[k]];
+                        if (k == i || k == j || cell.isConfirmed() || (cell.state & pair) == 0) continue;
+                        if (!restrict_cell(group[k], cell.state & ~pair, work, trail)) return false;
+                    }
+                    break;
+                }
+            }
+
+            mask_type where[size + 1] = {}; // where[d]: unit positions still holding digit d
+            const mask_type confirmed = unit_digits[unit]; // may not have left the peers yet
+            for (uint8_t i = 0; i < size; ++i) {
+                const mask_type state = cells[group[i]].state;
+                if (state & 0b1) continue;
+                for (uint8_t d = 1; d <= size; ++d)
+                    if (state >> d & 1) where[d] |= static_cast<mask_type>(mask_type{1} << i);
+            }
+            for (uint8_t d1 = 1; d1 <= size; ++d1) {
+                if ((confirmed >> d1 & 1) || detail::popcount(where[d1]) != 2) continue;
+                for (uint8_t d2 = d1 + 1; d2 <= size; ++d2) {
+                    if ((confirmed >> d2 & 1) || where[d2] != where[d1]) continue;
+                    const mask_type keep = static_cast<mask_type>(mask_type{1} << d1 | mask_type{1} << d2);
+                    for (mask_type pos = where[d1]; pos; pos &= pos - 1) {
+                        const index_type idx = group[detail::get_power_of_two_runtime(pos & -pos)];
+                        const mask_type state = cells[idx].state;
+                        if ((state & ~keep) == 0) continue;
+                        if (!restrict_cell(idx, state & keep, work, trail)) return false;
+                    }
+                    break;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Bound the candidates of a killer cage by its sum.
+         *
+         * <p>
+         * The other cells of the cage contribute at least the sum of their
+         * lowest candidates and at most the sum of their highest, so each cell
+         * keeps only the digits that leave the rest of the sum within those
+         * bounds. Distinct digits are already enforced by peer elimination; a
+         * full cage ends up with exactly its sum.
+         * </p>
+         */
+        template<typename Trail>
+        SD_CONSTEXPR20 bool deduce_cage(const uint8_t unit, worklist &work, Trail &trail) {
+            const index_type *group = tables().units[unit];
+            const uint8_t length = tables().unit_length[unit];
+            const int sum = tables().unit_sum[unit];
+            int low = 0, high = 0;
+            for (uint8_t i = 0; i < length; ++i) {
+                const mask_type mask = cells[group[i]].possibleMask();
+                if (mask == 0) return false;
+                low += detail::get_power_of_two_runtime(mask & -mask);
+                high += detail::highest_bit(mask);
+            }
+            if (low > sum || high < sum) return false;
+
+            for (uint8_t i = 0; i < length; ++i) {
+                const cell_type &cell = cells[group[i]];
+                if (cell.isConfirmed()) continue;
+                const mask_type mask = cell.possibleMask();
+                const int least = sum - (high - detail::highest_bit(mask));
+                const int most = sum - (low - detail::get_power_of_two_runtime(mask & -mask));
+                mask_type keep = 0;
+                for (int d = least < 1 ? 1 : least; d <= most && d <= size; ++d)
+                    keep |= static_cast<mask_type>(mask_type{1} << d);
+                if ((mask & ~keep) == 0) continue;
+                if (!restrict_cell(group[i], mask & keep, work, trail)) return false;
+            }
+            return true;
+        }
+
+        [[nodiscard]] SD_CONSTEXPR20 bool check_initial_valid() const {
+            for (uint8_t u = 0; u < unit_count; ++u)
+                if (!check_unit(u)) return false;
+            return true;
+        }
+
+        /**
+         * @brief Check that no digit is confirmed twice in one unit, nor a cage's sum broken.
+         */
+        [[nodiscard]] SD_CONSTEXPR20 bool check_unit(const uint8_t unit) const {
+            const index_type *group = tables().units[unit];
+            const uint8_t length = unit_length(unit);
+            mask_type confirmed = 0b0;
+            for (uint8_t i = 0; i < length; ++i) {
+                const cell_type &cell = cells[group[i]];
+                if (cell.isConfirmed()) {
+                    const mask_type mask = cell.possibleMask();
+                    if ((confirmed & mask) != 0) return false; // duplicate
+                    confirmed |= mask;
+                }
+            }
+            if constexpr (Units::cage_count != 0)
+                if (unit >= full_unit_count) return check_cage_sum(unit);
+            return true;
+        }
+
+        /**
+         * @brief A cage's confirmed digits stay within its sum, and meet it once the cage is full.
+         */
+        [[nodiscard]] SD_CONSTEXPR20 bool check_cage_sum(const uint8_t unit) const {
+            const index_type *group = tables().units[unit];
+            const uint8_t length = tables().unit_length[unit];
+            uint16_t sum = 0;
+            uint8_t filled = 0;
+            for (uint8_t i = 0; i < length; ++i) {
+                if (!cells[group[i]].isConfirmed()) continue;
+                sum = static_cast<uint16_t>(sum + cells[group[i]].getConfirmedValue());
+                ++filled;
+            }
+            const uint16_t target = tables().unit_sum[unit];
+            return sum <= target && (filled < length || sum == target);
+        }
+
+        static SD_CONSTEXPR20 bool check_unit(const array<cell_type *, size> &group) {
+            mask_type confirmed = 0b0;
+            for (const auto *cell: group) {
+                if (cell->isConfirmed()) {
+                    const mask_type mask = cell->possibleMask();
+                    if ((confirmed & mask) != 0) return false; // duplicate
+                    confirmed |= mask;
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief The classic 9x9 board; every 9x9-only API (batch, packed, C) works on this type.
+     */
+    using Board = BasicBoard<3, 3>;
+
+    static_assert(sizeof(Board::cell_type) == 2 && sizeof(Board::index_type) == 1,
+                  "9x9 boards keep 16-bit cells and 8-bit indices");
+
+    // =========================
+    //   BRANCH SELECTION
+    // =========================
+
+    /**
+     * @brief How the search chooses what to branch on at each node.
+     */
+    enum class Branching : uint8_t {
+        linear,     ///< Full scan for the first cell with the fewest candidates (original)
+        mrv,        ///< Same choice, but the scan stops at the first 2-candidate cell
+        mrv_degree, ///< Bucket the fewest-candidate cells, break ties by most undecided peers
+        unit_digit  ///< Like mrv, but may branch on the cells of a digit with fewer places in a unit
+    };
+
+    namespace detail {
+        /**
+         * @brief A branch point: either the candidates of a cell or the places of a digit in a unit.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols>
+        struct Branch {
+            using geometry = Geometry<BoxRows, BoxCols>;
+
+            typename geometry::signed_index target; ///< Cell index (digit == 0) or unit index; -1 if the board is solved
+            uint8_t digit;                          ///< 0 to branch over the cell's candidates, else the digit being placed
+            typename geometry::mask_type mask;      ///< Candidate bits of the cell, or unit positions (bits 0–size-1) of the digit
+        };
+
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        SD_CONSTEXPR20 Branch<BoxRows, BoxCols> branch_on_cell(const BasicBoard<BoxRows, BoxCols, Units> &board,
+                                                               const typename Geometry<BoxRows, BoxCols>::signed_index idx) {
+            return {idx, 0, board.cells[idx].possibleMask()};
+        }
+
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        SD_CONSTEXPR20 Branch<BoxRows, BoxCols> pick_mrv(const BasicBoard<BoxRows, BoxCols, Units> &board) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using signed_index = typename board_type::signed_index;
+            uint8_t min_choices = board_type::size + 1;
+            signed_index target_idx = -1;
+            for (signed_index i = 0; i < static_cast<signed_index>(board_type::cell_count); ++i) {
+                const auto &cell = board.cells[i];
+                if (cell.isConfirmed()) continue;
+                const uint8_t count = popcount(cell.possibleMask());
+                if (count < min_choices) {
+                    min_choices = count;
+                    target_idx = i;
+                    if (count <= 2) break; // nothing undecided can have fewer
+                }
+            }
+            return branch_on_cell(board, target_idx);
+        }
+
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        SD_CONSTEXPR20 Branch<BoxRows, BoxCols> pick_mrv_degree(const BasicBoard<BoxRows, BoxCols, Units> &board) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using signed_index = typename board_type::signed_index;
+            constexpr uint16_t words = (board_type::cell_count + 63) / 64;
+            uint64_t bucket[words] = {}; // cells having the current minimum candidate count
+            uint64_t undecided[words] = {};
+            uint8_t min_choices = board_type::size + 1;
+            for (uint16_t i = 0; i < board_type::cell_count; ++i) {
+                const auto &cell = board.cells[i];
+                if (cell.isConfirmed()) continue;
+                undecided[i >> 6] |= uint64_t{1} << (i & 63);
+                const uint8_t count = popcount(cell.possibleMask());
+                if (count < min_choices) {
+                    min_choices = count;
+                    for (uint64_t &word: bucket) word = 0; // NOLINT for range-based for
+                }
+                if (count == min_choices) bucket[i >> 6] |= uint64_t{1} << (i & 63);
+            }
+
+            signed_index target_idx = -1;
+            int8_t best_degree = -1;
+            for (uint16_t i = 0; i < board_type::cell_count; ++i) {
+                if (!(bucket[i >> 6] >> (i & 63) & 1)) continue;
+                int8_t degree = 0;
+                const auto *peers = board_type::tables().peers[i];
+                for (uint8_t k = 0; k < board_type::peer_count; ++k)
+                    degree += static_cast<int8_t>(undecided[peers[k] >> 6] >> (peers[k] & 63) & 1);
+                if (degree > best_degree) {
+                    best_degree = degree;
+                    target_idx = static_cast<signed_index>(i);
+                }
+            }
+            return branch_on_cell(board, target_idx);
+        }
+
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        SD_CONSTEXPR20 Branch<BoxRows, BoxCols> pick_unit_digit(const BasicBoard<BoxRows, BoxCols, Units> &board) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using mask_type = typename board_type::mask_type;
+            Branch<BoxRows, BoxCols> best = pick_mrv(board);
+            uint8_t best_count = popcount(best.mask);
+            if (best_count <= 2) return best;
+
+            for (uint8_t u = 0; u < board_type::full_unit_count; ++u) {
+                const auto *group = board_type::tables().units[u];
+                mask_type once = 0, twice = 0, thrice = 0;
+                for (uint8_t i = 0; i < board_type::size; ++i) {
+                    const mask_type state = board.cells[group[i]].state;
+                    thrice |= twice & state;
+                    twice |= once & state;
+                    once |= state;
+                }
+                const mask_type open = board_type::full_mask & ~board.unit_digits[u];
+                const mask_type single = open & once & ~twice; // only without hidden-single deduction
+                const mask_type pair = open & twice & ~thrice;
+                mask_type digits = single;
+                if (!digits) {
+                    if (!pair || best_count <= 2) continue;
+                    digits = pair;
+                }
+
+                const mask_type bit = digits & -digits;
+                mask_type positions = 0;
+                for (uint8_t i = 0; i < board_type::size; ++i)
+                    if (board.cells[group[i]].state & bit) positions |= static_cast<mask_type>(mask_type{1} << i);
+                best = {static_cast<typename board_type::signed_index>(u),
+                        static_cast<uint8_t>(get_power_of_two_runtime(bit)), positions};
+                best_count = single ? 1 : 2;
+                if (best_count == 1) break;
+            }
+            return best;
+        }
+
+        /**
+         * @brief Choose the next branch point of a fully propagated board.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        SD_CONSTEXPR20 Branch<BoxRows, BoxCols> pick_branch(const BasicBoard<BoxRows, BoxCols, Units> &board, const Branching strategy) {
+            if (board.confirmed_count == BasicBoard<BoxRows, BoxCols, Units>::cell_count) return {-1, 0, 0};
+            switch (strategy) {
+                case Branching::linear: return branch_on_cell(board, board.pick_branch());
+                case Branching::mrv_degree: return pick_mrv_degree(board);
+                case Branching::unit_digit: return pick_unit_digit(board);
+                default: return pick_mrv(board);
+            }
+        }
+
+        /**
+         * @brief Take one alternative <code>pick</code> (a single bit of the branch mask).
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Trail>
+        SD_CONSTEXPR20 bool take_branch(BasicBoard<BoxRows, BoxCols, Units> &board,
+                                        const typename Geometry<BoxRows, BoxCols>::index_type target,
+                                        const uint8_t digit, const typename Geometry<BoxRows, BoxCols>::mask_type pick,
+                                        Trail &trail, const DeductionLevel level) {
+            using mask_type = typename Geometry<BoxRows, BoxCols>::mask_type;
+            if (digit == 0) return board.place(target, pick, trail, level);
+            const auto idx = board.tables().units[target][get_power_of_two_runtime(pick)];
+            return board.place(idx, static_cast<mask_type>(mask_type{1} << digit), trail, level);
+        }
+    }
+
+    // =========================
+    //   BACKTRACKING SOLVER
+    // =========================
+
+    /**
+     * @brief Internal stack frame for iterative backtracking.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units = StandardUnits<BoxRows, BoxCols>>
+    struct BasicFrame {
+        BasicBoard<BoxRows, BoxCols, Units> board{};
+        typename detail::Geometry<BoxRows, BoxCols>::mask_type remaining_mask{}; ///< Alternatives not tried yet
+        typename detail::Geometry<BoxRows, BoxCols>::index_type target_idx{};    ///< Cell, or unit when <code>digit</code> is set
+        uint8_t digit{};           ///< 0 for a cell branch, else the digit placed within the unit
+    };
+
+    /**
+     * @brief Stack frame of the trail engine: a branch point, without a board copy.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols>
+    struct BasicTrailFrame {
+        typename detail::Geometry<BoxRows, BoxCols>::mask_type remaining_mask{};
+        uint16_t trail_mark{};  ///< Trail size when this frame was entered
+        typename detail::Geometry<BoxRows, BoxCols>::index_type target_idx{};
+        uint8_t digit{};
+    };
+
+    using Frame = BasicFrame<3, 3>;
+    using TrailFrame = BasicTrailFrame<3, 3>;
+
+    /**
+     * @brief Backtracking strategy used by <code>solve()</code>.
+     */
+    enum class SearchEngine : uint8_t {
+        copy,      ///< Every frame snapshots the full board (original engine)
+        trail,     ///< One working board changed in place, undone from a trail of changed cells
+        dlx,       ///< Exact cover (Algorithm X over Dancing Links) on the propagated board
+        automatic  ///< Chosen per puzzle from the board size and the clue count
+    };
+
+    /**
+     * @brief Tunables for a single <code>solve()</code> call.
+     */
+    struct SolveOptions {
+        SearchEngine engine = SearchEngine::trail;
+        DeductionLevel deduction = DeductionLevel::hidden_singles;
+        Branching branching = Branching::mrv_degree;
+    };
+
+    /**
+     * @brief What one search did, filled in by the <code>SolveStats</code> overloads.
+     *
+     * <p>
+     * Only those overloads record anything; every other entry point runs with
+     * an empty recorder whose calls compile away. The two timer fields stay 0
+     * unless <code>SD_ENABLE_CYCLE_TIMERS</code> is set.
+     * </p>
+     */
+    struct SolveStats {
+        uint64_t guesses;        ///< Alternatives tried (the same count as <code>SolverWorkspace::nodes</code>)
+        uint64_t backtracks;     ///< Branch points abandoned after their last alternative
+        uint64_t contradictions; ///< Propagations that ended in a contradiction
+        uint64_t propagations;   ///< Deduction passes: the root propagation plus one per guess
+        uint64_t solutions;      ///< Solutions reached
+        uint64_t max_depth;      ///< Deepest branch-point stack
+        uint64_t deduce_cycles;  ///< Ticks spent propagating guesses (<code>SD_ENABLE_CYCLE_TIMERS</code>)
+        uint64_t branch_cycles;  ///< Ticks spent choosing branch points (<code>SD_ENABLE_CYCLE_TIMERS</code>)
+    };
+
+    /**
+     * @brief Fixed node arena of the exact-cover (Dancing Links) engine.
+     *
+     * <p>
+     * The board is the exact-cover matrix of Knuth's Algorithm X: one column
+     * per cell and per (unit, digit) pair, one row per candidate with a node
+     * for its cell and for every unit holding all digits (four on the classic
+     * board). Killer cages are not exact-cover constraints and have no columns.
+     * Only the open part of a propagated board is linked in, so every column
+     * and row of a full board fits without any allocation. Node 0 is the root,
+     * nodes <code>1..column_count</code> are the column headers and the rows
+     * follow.
+     * </p>
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units = StandardUnits<BoxRows, BoxCols>>
+    struct BasicExactCover {
+        using geometry = detail::Layout<BoxRows, BoxCols, Units>;
+
+        /// Cells, then (unit, digit) pairs
+        static constexpr uint16_t column_count = geometry::cell_count + uint16_t{geometry::full_unit_count} * geometry::size;
+        /// Nodes of one candidate's row: its cell and each of its units holding all digits
+        static constexpr uint8_t row_length = 1 + geometry::units_per_cell - (Units::cage_count ? 1 : 0);
+        static constexpr uint32_t node_count = 1 + column_count + row_length * uint32_t{geometry::cell_count} * geometry::size;
+
+        using link_type = typename std::conditional<(node_count <= 0xFFFF), std::uint16_t, std::uint32_t>::type;
+
+        struct Node {
+            link_type left, right, up, down;
+            link_type column; ///< Header of the node's column (itself for a header)
+        };
+
+        Node nodes[node_count];
+        uint16_t candidate[node_count];           ///< Row nodes: <code>cell * size + digit - 1</code>
+        link_type column_size[column_count + 1];  ///< Rows left in each column, indexed by header
+        link_type choice[geometry::cell_count];   ///< Row node chosen at each search level
+    };
+
+    /**
+     * @brief Reusable scratch memory for the iterative backtracking solver.
+     *
+     * <p>
+     * Holds the full frame stack (at most one frame per cell), so a search never
+     * needs more than the workspace it is given. A workspace can live on the
+     * stack, inside an arena, or be kept per thread and reused across millions
+     * of <code>solve()</code> calls without any heap traffic.
+     * </p>
+     *
+     * <p>
+     * The trail engine only uses <code>board</code>, <code>frames</code> and
+     * <code>trail</code>: every cell changes at most <code>size</code> times along
+     * one search path (all but one candidate removed, then the confirmation),
+     * which bounds the trail.
+     * </p>
+     *
+     * <p>
+     * The exact-cover engine only uses <code>cover</code> and <code>board</code>
+     * (as the solution it hands out). Its node arena grows with the cube of
+     * the cell count (about 40 KB for 9x9, 780 KB for 25x25), so it is not part
+     * of the workspace. Point <code>cover</code> at a caller-owned
+     * <code>BasicExactCover</code> to keep it across solves. When
+     * <code>cover</code> is null, each exact-cover solve uses an arena in its
+     * own stack frame. That is fine for 9x9, but attach one for larger boards.
+     * </p>
+     *
+     * <p>
+     * A workspace (and the arena it points to) must not be shared by two
+     * concurrent solves. The copy engine's stack grows with the square of the
+     * cell count: a 9x9 workspace is about 21 KB, a 25x25 one about 1.8 MB.
+     * Allocate large workspaces accordingly.
+     * </p>
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units = StandardUnits<BoxRows, BoxCols>>
+    struct BasicWorkspace {
+        static constexpr uint16_t cell_count = detail::Geometry<BoxRows, BoxCols>::cell_count;
+        static constexpr uint8_t size = detail::Geometry<BoxRows, BoxCols>::size;
+        static_assert(uint32_t{cell_count} * size <= 0xFFFF, "trail marks are 16-bit");
+
+        BasicFrame<BoxRows, BoxCols, Units> stack[cell_count];                     ///< Copy engine: one frame per undecided cell at most
+        BasicBoard<BoxRows, BoxCols, Units> board;                                 ///< Trail engine: the working board
+        SD_CACHE_ALIGN BasicTrailFrame<BoxRows, BoxCols> frames[cell_count];       ///< Trail engine: branch points
+        SD_CACHE_ALIGN BasicUndoEntry<BoxRows, BoxCols> trail[cell_count * size];  ///< Trail engine: previous states of changed cells
+        BasicExactCover<BoxRows, BoxCols, Units> *cover = nullptr;                 ///< Exact-cover engine: caller-owned arena, or null
+        uint64_t nodes;                                                            ///< Guesses tried by the last solve
+    };
+
+    using SolverWorkspace = BasicWorkspace<3, 3>;
+
+    namespace detail {
+        /**
+         * @brief Per-thread default workspace used by <code>solve(Board &)</code>.
+         * @note Constant-initialized, so first use costs no dynamic initialization.
+         */
+        template<uint8_t BoxRows = 3, uint8_t BoxCols = 3, typename Units = StandardUnits<BoxRows, BoxCols>>
+        BasicWorkspace<BoxRows, BoxCols, Units> &default_workspace() {
+            thread_local BasicWorkspace<BoxRows, BoxCols, Units> workspace{};
+            return workspace;
+        }
+
+        /**
+         * @brief Current tick count of the cycle timers; 0 when they are disabled.
+         */
+        inline SD_CONSTEXPR20 uint64_t cycle_counter() noexcept {
+#if SD_ENABLE_CYCLE_TIMERS
+            if (is_constant_evaluated()) return 0;
+#  if SD_HAS_RDTSC
+            return __rdtsc();
+#  else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#  endif
+#else
+            return 0;
+#endif
+        }
+
+        /**
+         * @brief Statistics recorder that keeps nothing; the default of every search.
+         */
+        struct NoStats {
+            SD_CONSTEXPR20 void guess() const noexcept {}
+            SD_CONSTEXPR20 void backtrack() const noexcept {}
+            SD_CONSTEXPR20 void contradiction() const noexcept {}
+            SD_CONSTEXPR20 void propagation() const noexcept {}
+            SD_CONSTEXPR20 void solution() const noexcept {}
+            SD_CONSTEXPR20 void depth(uint64_t) const noexcept {}
+            [[nodiscard]] SD_CONSTEXPR20 uint64_t clock() const noexcept { return 0; }
+            SD_CONSTEXPR20 void deduce_since(uint64_t) const noexcept {}
+            SD_CONSTEXPR20 void branch_since(uint64_t) const noexcept {}
+        };
+
+        /**
+         * @brief Statistics recorder that accumulates into a <code>SolveStats</code>.
+         */
+        struct StatsRecorder {
+            SolveStats &out;
+
+            SD_CONSTEXPR20 void guess() noexcept { ++out.guesses; }
+            SD_CONSTEXPR20 void backtrack() noexcept { ++out.backtracks; }
+            SD_CONSTEXPR20 void contradiction() noexcept { ++out.contradictions; }
+            SD_CONSTEXPR20 void propagation() noexcept { ++out.propagations; }
+            SD_CONSTEXPR20 void solution() noexcept { ++out.solutions; }
+            SD_CONSTEXPR20 void depth(const uint64_t d) noexcept { if (d > out.max_depth) out.max_depth = d; }
+            [[nodiscard]] SD_CONSTEXPR20 uint64_t clock() const noexcept { return cycle_counter(); }
+            SD_CONSTEXPR20 void deduce_since(const uint64_t start) noexcept { out.deduce_cycles += clock() - start; }
+            SD_CONSTEXPR20 void branch_since(const uint64_t start) noexcept { out.branch_cycles += clock() - start; }
+        };
+
+        /**
+         * @brief Stop condition that never fires.
+         */
+        struct NeverStop {
+            constexpr bool operator()() const noexcept { return false; }
+        };
+
+        /**
+         * @brief Guesses between two polls of a search's stop condition.
+         */
+        constexpr uint64_t stop_poll_interval = 64;
+
+        /**
+         * @brief Solution handler that keeps the first solution in <code>target</code>.
+         */
+        template<typename BoardT>
+        struct KeepFirst {
+            BoardT &target;
+
+            SD_CONSTEXPR20 bool operator()(const BoardT &solution) const {
+                target = solution;
+                return true;
+            }
+        };
+
+        /**
+         * @brief Backtracking loop of the copy engine over an already seeded frame stack.
+         *
+         * <p>
+         * Every frame owns its board, so <code>stack[0..top]</code> is the complete
+         * state of the search: the loop can be left and re-entered with the same
+         * stack at any time. A stop leaves the interrupted frame's next
+         * alternative untried.
+         * </p>
+         *
+         * @param top Index of the deepest frame; -1 once the tree is exhausted.
+         * @param nodes Guess counter, advanced by one per alternative tried.
+         * @return true if <code>accept</code> ended the search, false if the tree was exhausted or stopped.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept, typename Stats>
+        SD_CONSTEXPR20 bool run_copy(BasicFrame<BoxRows, BoxCols, Units> *stack,
+                                     typename BasicBoard<BoxRows, BoxCols, Units>::signed_index &top, uint64_t &nodes,
+                                     const SolveOptions &options, Stop &stop, Accept &accept, Stats &stats) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using mask_type = typename board_type::mask_type;
+            using index_type = typename board_type::index_type;
+            NoTrail none;
+
+            while (top >= 0) {
+                auto &frame = stack[top]; // NOLINT for object auto-unpacking
+                const mask_type mask = frame.remaining_mask;
+
+                if (mask == 0) {
+                    --top; // no mask, backtrack
+                    stats.backtrack();
+                    continue;
+                }
+
+                // Lowest mask
+                const mask_type pick = mask & -mask;
+                if (SD_UNLIKELY((nodes + 1) % stop_poll_interval == 0) && stop()) return false;
+                frame.remaining_mask ^= pick;
+                ++nodes;
+                stats.guess();
+
+                board_type next = frame.board;
+                stats.propagation();
+                uint64_t clock = stats.clock();
+                const bool consistent = take_branch(next, frame.target_idx, frame.digit, pick, none, options.deduction);
+                stats.deduce_since(clock);
+                if (!consistent) {
+                    stats.contradiction();
+                    continue; // this guess fails, try the next candidate
+                }
+
+                clock = stats.clock();
+                const auto res = pick_branch(next, options.branching);
+                stats.branch_since(clock);
+                if (SD_UNLIKELY(res.target == -1)) {
+                    stats.solution();
+                    if (accept(next)) return true;
+                    continue; // keep enumerating
+                }
+
+                ++top;
+                stats.depth(static_cast<uint64_t>(top) + 1);
+                stack[top].board = next;
+                stack[top].target_idx = static_cast<index_type>(res.target);
+                stack[top].digit = res.digit;
+                stack[top].remaining_mask = res.mask;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Search where every frame holds its own copy of the board.
+         * @param stop Polled before every <code>stop_poll_interval</code>-th guess; the search gives up once it returns true.
+         * @param accept Called with every solution; returning false resumes the search for the next one.
+         * @param stats Recorder of search events (<code>NoStats</code> or <code>StatsRecorder</code>).
+         * @return true if <code>accept</code> ended the search, false if the tree was exhausted or stopped.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept, typename Stats>
+        SD_CONSTEXPR20 bool solve_copy(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                       const SolveOptions &options, Stop &stop, Accept &accept, Stats &stats) {
+            using index_type = typename BasicBoard<BoxRows, BoxCols, Units>::index_type;
+            BasicFrame<BoxRows, BoxCols, Units> *stack = workspace.stack;
+            NoTrail none;
+            typename BasicBoard<BoxRows, BoxCols, Units>::signed_index top = 0;
+            workspace.nodes = 0;
+
+            stats.propagation();
+            if (SD_UNLIKELY(!root.propagate_all(none, options.deduction))) { // invalid
+                stats.contradiction();
+                return false;
+            }
+            const uint64_t clock = stats.clock();
+            const auto branch = pick_branch(root, options.branching);
+            stats.branch_since(clock);
+            if (branch.target == -1) { // already solved
+                stats.solution();
+                return accept(root);
+            }
+
+            stats.depth(1);
+            stack[0].board = root;
+            stack[0].target_idx = static_cast<index_type>(branch.target);
+            stack[0].digit = branch.digit;
+            stack[0].remaining_mask = branch.mask;
+            return run_copy(stack, top, workspace.nodes, options, stop, accept, stats);
+        }
+
+        /**
+         * @brief Search on a single working board, undoing guesses from the trail.
+         * @param stop Polled before every <code>stop_poll_interval</code>-th guess; the search gives up once it returns true.
+         * @param accept Called with every solution; returning false resumes the search for the next one.
+         * @param stats Recorder of search events (<code>NoStats</code> or <code>StatsRecorder</code>).
+         * @return true if <code>accept</code> ended the search, false if the tree was exhausted or stopped.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept, typename Stats>
+        SD_CONSTEXPR20 bool solve_trail(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                        const SolveOptions &options, Stop &stop, Accept &accept, Stats &stats) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using mask_type = typename board_type::mask_type;
+            using index_type = typename board_type::index_type;
+            NoTrail none;
+            workspace.nodes = 0;
+            stats.propagation();
+            if (SD_UNLIKELY(!root.propagate_all(none, options.deduction))) { // invalid
+                stats.contradiction();
+                return false;
+            }
+            uint64_t clock = stats.clock();
+            const auto branch = pick_branch(root, options.branching);
+            stats.branch_since(clock);
+            if (branch.target == -1) { // already solved
+                stats.solution();
+                return accept(root);
+            }
+
+            board_type &board = workspace.board;
+            BasicTrailFrame<BoxRows, BoxCols> *frames = workspace.frames;
+            BasicTrailRecorder<BoxRows, BoxCols> trail{board.cells.begin(), workspace.trail, 0};
+            typename board_type::signed_index top = 0;
+
+            board = root;
+            stats.depth(1);
+            frames[0].target_idx = static_cast<index_type>(branch.target);
+            frames[0].digit = branch.digit;
+            frames[0].remaining_mask = branch.mask;
+            frames[0].trail_mark = 0;
+
+            while (top >= 0) {
+                auto &frame = frames[top]; // NOLINT for object auto-unpacking
+
+                // Roll the board back to the state this frame was entered with
+                while (trail.size > frame.trail_mark)
+                    board.undo(trail.entries[--trail.size]);
+
+                const mask_type mask = frame.remaining_mask;
+                if (mask == 0) {
+                    --top; // no mask, backtrack
+                    stats.backtrack();
+                    continue;
+                }
+
+                // Lowest mask
+                const mask_type pick = mask & -mask;
+                if (SD_UNLIKELY((workspace.nodes + 1) % stop_poll_interval == 0) && stop()) return false;
+                frame.remaining_mask ^= pick;
+                ++workspace.nodes;
+                stats.guess();
+
+                stats.propagation();
+                clock = stats.clock();
+                const bool consistent = take_branch(board, frame.target_idx, frame.digit, pick, trail, options.deduction);
+                stats.deduce_since(clock);
+                if (!consistent) {
+                    stats.contradiction();
+                    continue; // this guess fails, try the next candidate
+                }
+
+                clock = stats.clock();
+                const auto res = pick_branch(board, options.branching);
+                stats.branch_since(clock);
+                if (SD_UNLIKELY(res.target == -1)) {
+                    stats.solution();
+                    if (accept(board)) return true;
+                    continue; // keep enumerating; the next iteration undoes this solution
+                }
+
+                ++top;
+                stats.depth(static_cast<uint64_t>(top) + 1);
+                frames[top].target_idx = static_cast<index_type>(res.target);
+                frames[top].digit = res.digit;
+                frames[top].remaining_mask = res.mask;
+                frames[top].trail_mark = trail.size;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Algorithm X over the candidates of a propagated, unsolved board.
+         *
+         * <p>
+         * Links the open cells and (unit, digit) pairs of <code>root</code> into
+         * <code>cover</code> and runs the search there. Solutions are assembled
+         * in <code>workspace.board</code>.
+         * </p>
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept, typename Stats>
+        SD_CONSTEXPR20 bool search_cover(const BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                         BasicExactCover<BoxRows, BoxCols, Units> &cover, Stop &stop, Accept &accept, Stats &stats) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using mask_type = typename board_type::mask_type;
+            using index_type = typename board_type::index_type;
+            using cover_type = BasicExactCover<BoxRows, BoxCols, Units>;
+            using link_type = typename cover_type::link_type;
+            constexpr uint8_t size = board_type::size;
+            constexpr uint16_t cell_count = board_type::cell_count;
+            constexpr uint8_t row_length = cover_type::row_length;
+
+            typename cover_type::Node *n = cover.nodes;
+            link_type *column_size = cover.column_size;
+
+            // Column headers of the unsatisfied constraints, linked in a ring through the root
+            link_type last = 0;
+            const auto open_column = [&](const link_type h) {
+                n[h].up = n[h].down = n[h].column = h;
+                n[h].left = last;
+                n[last].right = h;
+                column_size[h] = 0;
+                last = h;
+            };
+            for (index_type i = 0; i < cell_count; ++i)
+                if (!root.cells[i].isConfirmed()) open_column(static_cast<link_type>(1 + i));
+            for (uint8_t u = 0; u < board_type::full_unit_count; ++u)
+                for (uint8_t d = 1; d <= size; ++d)
+                    if (!(root.unit_digits[u] >> d & 1u)) open_column(static_cast<link_type>(1 + cell_count + u * size + d - 1));
+            n[last].right = 0;
+            n[0].left = last;
+
+            // One row per remaining candidate: its cell, then its distinct units holding all digits
+            link_type next = 1 + cover_type::column_count;
+            for (index_type i = 0; i < cell_count; ++i) {
+                if (root.cells[i].isConfirmed()) continue;
+                const uint8_t *units = board_type::tables().cell_units[i];
+                uint8_t row_units[row_length - 1] = {};
+                uint8_t length = 0;
+                for (uint8_t k = 0; k < board_type::units_per_cell; ++k)
+                    if (units[k] < board_type::full_unit_count && (k < 3 || units[k] != units[0])) row_units[length++] = units[k];
+                for (mask_type mask = root.cells[i].possibleMask(); mask; mask &= mask - 1) {
+                    const mask_type bit = mask & -mask;
+                    if (root.placed_around(i) & bit)
+                        continue; // already placed in a unit; propagate_all leaves none of these
+                    const uint8_t d = get_power_of_two_runtime(bit);
+                    link_type headers[row_length] = {static_cast<link_type>(1 + i)};
+                    for (uint8_t k = 0; k < length; ++k)
+                        headers[k + 1] = static_cast<link_type>(1 + cell_count + row_units[k] * size + d - 1);
+                    const uint8_t nodes = length + 1;
+                    for (uint8_t k = 0; k < nodes; ++k) {
+                        const link_type x = static_cast<link_type>(next + k), h = headers[k];
+                        n[x].column = h;
+                        n[x].down = h;
+                        n[x].up = n[h].up;
+                        n[n[h].up].down = x;
+                        n[h].up = x;
+                        ++column_size[h];
+                        n[x].left = static_cast<link_type>(next + (k + nodes - 1) % nodes);
+                        n[x].right = static_cast<link_type>(next + (k + 1) % nodes);
+                        cover.candidate[x] = static_cast<uint16_t>(i * size + d - 1);
+                    }
+                    next = static_cast<link_type>(next + nodes);
+                }
+            }
+
+            const auto cover_column = [&](const link_type c) {
+                n[n[c].right].left = n[c].left;
+                n[n[c].left].right = n[c].right;
+                for (link_type i = n[c].down; i != c; i = n[i].down)
+                    for (link_type j = n[i].right; j != i; j = n[j].right) {
+                        n[n[j].down].up = n[j].up;
+                        n[n[j].up].down = n[j].down;
+                        --column_size[n[j].column];
+                    }
+            };
+            const auto uncover_column = [&](const link_type c) {
+                for (link_type i = n[c].up; i != c; i = n[i].up)
+                    for (link_type j = n[i].left; j != i; j = n[j].left) {
+                        ++column_size[n[j].column];
+                        n[n[j].down].up = j;
+                        n[n[j].up].down = j;
+                    }
+                n[n[c].right].left = c;
+                n[n[c].left].right = c;
+            };
+
+            // choice[0..top] holds a column header (level just opened) or the row being tried
+            link_type *choice = cover.choice;
+            typename board_type::signed_index top = -1;
+            bool advance = false; // false: open a new level below top; true: move top to its next row
+            while (true) {
+                if (!advance) {
+                    advance = true;
+                    if (SD_UNLIKELY(n[0].right == 0)) { // every constraint covered
+                        stats.solution();
+                        board_type &solution = workspace.board;
+                        solution = root;
+                        for (typename board_type::signed_index level = 0; level <= top; ++level) {
+                            const uint16_t candidate = cover.candidate[choice[level]];
+                            solution.cells[candidate / size].state =
+                                    static_cast<mask_type>(mask_type{1} << (candidate % size + 1) | 1u);
+                        }
+                        solution.sync_placement();
+                        if (accept(solution)) return true;
+                    } else {
+                        const uint64_t clock = stats.clock();
+                        link_type best = n[0].right;
+                        for (link_type c = n[best].right; c != 0 && column_size[best] > 1; c = n[c].right)
+                            if (column_size[c] < column_size[best]) best = c;
+                        stats.branch_since(clock);
+                        if (column_size[best] == 0) {
+                            stats.contradiction();
+                        } else {
+                            cover_column(best);
+                            choice[++top] = best;
+                            stats.depth(static_cast<uint64_t>(top) + 1);
+                        }
+                    }
+                    if (top < 0) return false;
+                    continue;
+                }
+
+                // Take back the row tried at this level, then try the one below it
+                const link_type current = choice[top];
+                const link_type column = n[current].column;
+                if (current != column)
+                    for (link_type j = n[current].left; j != current; j = n[j].left) uncover_column(n[j].column);
+                const link_type row = n[current].down;
+                if (row == column) {
+                    uncover_column(column);
+                    stats.backtrack();
+                    if (--top < 0) return false;
+                    continue;
+                }
+
+                if (SD_UNLIKELY((workspace.nodes + 1) % stop_poll_interval == 0) && stop()) return false;
+                ++workspace.nodes;
+                stats.guess();
+                const uint64_t clock = stats.clock();
+                choice[top] = row;
+                for (link_type j = n[row].right; j != row; j = n[j].right) cover_column(n[j].column);
+                stats.deduce_since(clock);
+                advance = false;
+            }
+        }
+
+        /**
+         * @brief Exact-cover search over the open part of the propagated board.
+         *
+         * <p>
+         * After the root propagation the remaining candidates are linked into
+         * <code>workspace.cover</code> and Algorithm X runs on it, always
+         * branching on the constraint with the fewest rows left. A guess only
+         * covers columns; no deduction runs below the root, so
+         * <code>options.deduction</code> and <code>options.branching</code>
+         * apply to the root alone. Boards with killer cages fall back to the
+         * trail engine, since a sum is no exact-cover constraint. Without an
+         * arena attached to the workspace the search uses one in its own stack
+         * frame.
+         * </p>
+         *
+         * @param stop Polled before every <code>stop_poll_interval</code>-th guess; the search gives up once it returns true.
+         * @param accept Called with every solution; returning false resumes the search for the next one.
+         * @param stats Recorder of search events (<code>NoStats</code> or <code>StatsRecorder</code>).
+         * @return true if <code>accept</code> ended the search, false if the tree was exhausted or stopped.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept, typename Stats>
+        SD_CONSTEXPR20 bool solve_dlx(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                      const SolveOptions &options, Stop &stop, Accept &accept, Stats &stats) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            using cover_type = BasicExactCover<BoxRows, BoxCols, Units>;
+            constexpr uint16_t cell_count = board_type::cell_count;
+            if constexpr (Units::cage_count != 0) return solve_trail(root, workspace, options, stop, accept, stats);
+
+            NoTrail none;
+            workspace.nodes = 0;
+            stats.propagation();
+            if (SD_UNLIKELY(!root.propagate_all(none, options.deduction))) { // invalid
+                stats.contradiction();
+                return false;
+            }
+            if (root.confirmed_count == cell_count) { // already solved
+                stats.solution();
+                return accept(root);
+            }
+
+            if (workspace.cover) return search_cover(root, workspace, *workspace.cover, stop, accept, stats);
+            if (is_constant_evaluated()) { // no uninitialized storage at compile time
+                cover_type cover{};
+                return search_cover(root, workspace, cover, stop, accept, stats);
+            }
+            cover_type cover; // every node and count is written before it is read
+            return search_cover(root, workspace, cover, stop, accept, stats);
+        }
+
+        /**
+         * @brief Engine used by <code>SearchEngine::automatic</code> for this board.
+         *
+         * <p>
+         * Propagation pays for itself on 9x9 boards and on dense larger ones.
+         * Boards above 9x9 with fewer than 30% of their cells given are where it
+         * stalls: there exact cover searches orders of magnitude fewer nodes.
+         * </p>
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+        SD_CONSTEXPR20 SearchEngine pick_engine(const BasicBoard<BoxRows, BoxCols, Units> &board) {
+            using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+            if (board_type::size <= 9) return SearchEngine::trail;
+            uint32_t clues = 0;
+            for (const auto &cell: board.cells) clues += cell.isConfirmed(); // NOLINT for range-based for
+            return clues * 10 < uint32_t{board_type::cell_count} * 3 ? SearchEngine::dlx : SearchEngine::trail;
+        }
+
+        /**
+         * @brief Run the engine selected by <code>options</code>.
+         */
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept, typename Stats>
+        SD_CONSTEXPR20 bool search(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                   const SolveOptions &options, Stop &stop, Accept &accept, Stats &stats) {
+            switch (options.engine == SearchEngine::automatic ? pick_engine(root) : options.engine) {
+                case SearchEngine::copy: return solve_copy(root, workspace, options, stop, accept, stats);
+                case SearchEngine::dlx: return solve_dlx(root, workspace, options, stop, accept, stats);
+                default: return solve_trail(root, workspace, options, stop, accept, stats);
+            }
+        }
+
+        template<uint8_t BoxRows, uint8_t BoxCols, typename Units, typename Stop, typename Accept>
+        SD_CONSTEXPR20 bool search(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                   const SolveOptions &options, Stop &stop, Accept &accept) {
+            NoStats none;
+            return search(root, workspace, options, stop, accept, none);
+        }
+    }
+
+    /**
+     * @brief Solve the given Sudoku board using iterative backtracking.
+     * @param root Board to solve (in-place).
+     * @param workspace Caller-owned search memory, reused across calls.
+     * @param options Engine, deduction level and branching strategy.
+     * @return true if solved, false otherwise.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 bool solve(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                              const SolveOptions &options) {
+        detail::NeverStop never;
+        detail::KeepFirst<BasicBoard<BoxRows, BoxCols, Units>> keep{root};
+        return detail::search(root, workspace, options, never, keep);
+    }
+
+    /**
+     * @brief Solve the given Sudoku board and report what the search did.
+     * @param root Board to solve (in-place).
+     * @param workspace Caller-owned search memory, reused across calls.
+     * @param options Engine, deduction level and branching strategy.
+     * @param stats Overwritten with the counters of this search.
+     * @return true if solved, false otherwise.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 bool solve(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                              const SolveOptions &options, SolveStats &stats) {
+        stats = SolveStats{};
+        detail::NeverStop never;
+        detail::KeepFirst<BasicBoard<BoxRows, BoxCols, Units>> keep{root};
+        detail::StatsRecorder recorder{stats};
+        return detail::search(root, workspace, options, never, keep, recorder);
+    }
+
+    /**
+     * @brief Solve the given Sudoku board using iterative backtracking.
+     * @param root Board to solve (in-place).
+     * @param workspace Caller-owned search memory, reused across calls.
+     * @return true if solved, false otherwise.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 bool solve(BasicBoard<BoxRows, BoxCols, Units> &root, BasicWorkspace<BoxRows, BoxCols, Units> &workspace) {
+        return solve(root, workspace, SolveOptions{});
+    }
+
+    /**
+     * @brief Solve the given Sudoku board using the calling thread's default workspace.
+     * @param root Board to solve (in-place).
+     * @return true if solved, false otherwise.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 bool solve(BasicBoard<BoxRows, BoxCols, Units> &root) {
+        if (detail::is_constant_evaluated()) { // no thread_local storage at compile time
+            BasicWorkspace<BoxRows, BoxCols, Units> workspace{};
+            return solve(root, workspace);
+        }
+        return solve(root, detail::default_workspace<BoxRows, BoxCols, Units>());
+    }
+
+    // =========================
+    //   SOLUTION COUNTING
+    // =========================
+
+    /**
+     * @brief Count the solutions of a board, stopping as soon as <code>limit</code> are found.
+     *
+     * <p>
+     * Runs the same iterative engine as <code>solve()</code>, resuming the search
+     * after every solution instead of returning. Use a small limit: checking a
+     * generated puzzle needs <code>limit = 2</code> at most.
+     * </p>
+     *
+     * @param board Puzzle to examine (taken by value; the caller's board is untouched).
+     * @param limit Maximum number of solutions to look for; 0 returns 0 immediately.
+     * @param workspace Caller-owned search memory, reused across calls.
+     * @param options Engine, deduction level and branching strategy.
+     * @return Number of solutions found, at most <code>limit</code>.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 uint32_t count_solutions(BasicBoard<BoxRows, BoxCols, Units> board, const uint32_t limit,
+                                            BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                            const SolveOptions &options = SolveOptions{}) {
+        if (limit == 0) return 0;
+        uint32_t count = 0;
+        detail::NeverStop never;
+        auto accept = [&count, limit](const BasicBoard<BoxRows, BoxCols, Units> &) { return ++count >= limit; };
+        detail::search(board, workspace, options, never, accept);
+        return count;
+    }
+
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 uint32_t count_solutions(const BasicBoard<BoxRows, BoxCols, Units> &board, const uint32_t limit) {
+        if (detail::is_constant_evaluated()) {
+            BasicWorkspace<BoxRows, BoxCols, Units> workspace{};
+            return count_solutions(board, limit, workspace);
+        }
+        return count_solutions(board, limit, detail::default_workspace<BoxRows, BoxCols, Units>());
+    }
+
+    /**
+     * @brief True if the board has exactly one solution.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 bool has_unique_solution(const BasicBoard<BoxRows, BoxCols, Units> &board,
+                                            BasicWorkspace<BoxRows, BoxCols, Units> &workspace,
+                                            const SolveOptions &options = SolveOptions{}) {
+        return count_solutions(board, 2, workspace, options) == 1;
+    }
+
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 bool has_unique_solution(const BasicBoard<BoxRows, BoxCols, Units> &board) {
+        return count_solutions(board, 2) == 1;
+    }
+
+    // =========================
+    //   TRIAGE
+    // =========================
+
+    /**
+     * @brief What triage can tell about a puzzle without searching.
+     */
+    enum class Verdict : uint8_t {
+        open = 0,       ///< Consistent so far; only a search can tell how many solutions it has
+        unique = 1,     ///< Deduction alone completes it, so the solution is unique
+        ambiguous = 2,  ///< Too few clues or digits for a unique solution (it may still have none)
+        invalid = 3,    ///< Givens repeat a digit in a row, column or box
+        unsolvable = 4  ///< Deduction reaches a contradiction: no solution exists
+    };
+
+    /**
+     * @brief Weakest deduction level that completes a puzzle.
+     */
+    enum class Difficulty : uint8_t {
+        naked_singles = 0,  ///< Peer elimination alone
+        hidden_singles = 1, ///< Needs hidden singles
+        pairs = 2,          ///< Needs naked or hidden pairs
+        search = 3          ///< Deduction stalls; guessing is required
+    };
+
+    /**
+     * @brief Result of <code>triage()</code>.
+     */
+    struct Triage {
+        Verdict verdict;
+        Difficulty difficulty; ///< Level reached: the completing one, or where a contradiction or stall showed up
+        uint16_t clues;        ///< Given cells
+        uint8_t digits;        ///< Distinct digits among the givens
+        uint16_t open_cells;   ///< Cells left undecided by the strongest deduction; 0 unless <code>search</code>
+    };
+
+    /**
+     * @brief Classify a puzzle from its givens and the deduction stages alone, without guessing.
+     *
+     * <p>
+     * Runs the three deduction levels in turn on a copy of the board, each
+     * continuing from the last, and stops at the first that completes the
+     * board or finds a contradiction. That costs about as much as the root
+     * propagation of a search: as much as solving an easy puzzle, a fraction
+     * of a hard one. A puzzle neither completed nor refuted is reported
+     * <code>ambiguous</code> if it has fewer than <code>size - 1</code> distinct
+     * digits (two missing digits can always be swapped) or, on the classic 9x9
+     * board, fewer than 17 clues (no 16-clue puzzle is unique); otherwise it is
+     * <code>open</code>. Neither bound applies to killer cages, whose sums
+     * tell digits apart.
+     * </p>
+     *
+     * @param puzzle Board to examine; not modified.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 Triage triage(const BasicBoard<BoxRows, BoxCols, Units> &puzzle) {
+        using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+        Triage result{};
+        typename board_type::mask_type seen = 0;
+        for (const auto &cell: puzzle.cells) { // NOLINT for range-based for
+            if (!cell.isConfirmed()) continue;
+            ++result.clues;
+            seen |= cell.possibleMask();
+        }
+        result.digits = detail::popcount(seen);
+        if (!puzzle.check_initial_valid()) {
+            result.verdict = Verdict::invalid;
+            return result;
+        }
+
+        board_type board = puzzle;
+        detail::NoTrail none;
+        for (const DeductionLevel level: {DeductionLevel::naked_singles, DeductionLevel::hidden_singles,
+                                          DeductionLevel::pairs}) {
+            result.difficulty = static_cast<Difficulty>(level);
+            if (!board.propagate_all(none, level)) {
+                result.verdict = Verdict::unsolvable;
+                return result;
+            }
+            if (board.confirmed_count == board_type::cell_count) {
+                result.verdict = Verdict::unique;
+                return result;
+            }
+        }
+
+        result.difficulty = Difficulty::search;
+        result.open_cells = static_cast<uint16_t>(board_type::cell_count - board.confirmed_count);
+        const bool too_few_clues = std::is_same<Units, StandardUnits<3, 3>>::value && result.clues < 17;
+        const bool swappable = Units::cage_count == 0 && result.digits + 1 < board_type::size;
+        result.verdict = too_few_clues || swappable ? Verdict::ambiguous : Verdict::open;
+        return result;
+    }
+
+    // =========================
+    //   CANDIDATE GRID
+    // =========================
+
+    /**
+     * @brief Live pencil-mark grid for interactive editing: placements plus the candidates they leave.
+     *
+     * <p>
+     * Candidates come from peer elimination alone. An empty cell holds every
+     * digit no peer has placed, and nothing is ever placed automatically.
+     * <code>place()</code> and <code>remove()</code> therefore touch only the
+     * edited cell and its peers, and take well under a microsecond. Each call
+     * returns the cells whose <code>possibleMask()</code> changed. Hints and
+     * conflict highlighting can be answered from that without re-solving.
+     * </p>
+     * <p>
+     * A conflicting placement (a digit some peer already holds) is kept, so
+     * the grid shows what the user typed, and it is reported as inconsistent.
+     * The grid holds only its cells and is trivially copyable.
+     * </p>
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units = StandardUnits<BoxRows, BoxCols>>
+    class BasicCandidateGrid {
+    public:
+        using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+        using cell_type = typename board_type::cell_type;
+        using mask_type = typename board_type::mask_type;
+        using index_type = typename board_type::index_type;
+
+        static constexpr uint8_t size = board_type::size;
+        static constexpr uint16_t cell_count = board_type::cell_count;
+        static constexpr uint8_t max_changes = board_type::peer_count + 1;
+
+        /**
+         * @brief One cell whose state an edit changed.
+         */
+        struct Change {
+            index_type cell;
+            mask_type mask; ///< New <code>possibleMask()</code>: the placed digit's bit, or the candidates
+        };
+
+        /**
+         * @brief Outcome of one edit.
+         */
+        struct Update {
+            bool consistent; ///< false if the edit placed a digit a peer holds or left a changed cell without candidates
+            uint8_t count;   ///< Entries of <code>changes</code>; the edited cell comes first
+            Change changes[max_changes];
+        };
+
+        /// Empty grid: every cell holds every digit
+        SD_CONSTEXPR20 BasicCandidateGrid() noexcept {
+            for (cell_type &cell: cells_) cell.state = board_type::full_mask; // NOLINT for range-based for
+        }
+
+        /// Grid of a puzzle's confirmed cells; the candidates of the others are recomputed
+        explicit SD_CONSTEXPR20 BasicCandidateGrid(const board_type &puzzle) noexcept {
+            for (index_type i = 0; i < cell_count; ++i) {
+                const cell_type &cell = puzzle.cells[i];
+                cells_[i].state = cell.isConfirmed() ? cell.state : board_type::full_mask;
+            }
+            for (index_type i = 0; i < cell_count; ++i)
+                if (!cells_[i].isConfirmed()) cells_[i].state = open_candidates(i);
+        }
+
+        /**
+         * @brief Put <code>digit</code> in <code>cell</code>, replacing whatever was there.
+         * @param digit 1–<code>size</code>; 0 clears the cell like <code>remove()</code>.
+         */
+        SD_CONSTEXPR20 Update place(const index_type cell, const uint8_t digit) noexcept {
+            if (digit == 0 || digit > size) return remove(cell);
+            Update update{};
+            update.consistent = (placed_among_peers(cell) >> digit & 1) == 0;
+            cells_[cell].state = static_cast<mask_type>(0b1 | mask_type{1} << digit);
+            record(update, cell);
+            refresh_peers(cell, update);
+            return update;
+        }
+
+        /**
+         * @brief Clear a placed cell; its peers may regain the digit it held.
+         */
+        SD_CONSTEXPR20 Update remove(const index_type cell) noexcept {
+            Update update{};
+            update.consistent = true;
+            if (!cells_[cell].isConfirmed()) return update;
+            cells_[cell].state = open_candidates(cell);
+            record(update, cell);
+            refresh_peers(cell, update);
+            return update;
+        }
+
+        /// Candidate bits (1–<code>size</code>) of an empty cell, or the bit of the placed digit
+        [[nodiscard]] SD_CONSTEXPR20 mask_type candidates(const index_type cell) const noexcept {
+            return cells_[cell].possibleMask();
+        }
+
+        /// Placed digit of a cell; 0 if it is empty
+        [[nodiscard]] SD_CONSTEXPR20 uint8_t digit(const index_type cell) const noexcept {
+            return static_cast<uint8_t>(cells_[cell].getConfirmedValue());
+        }
+
+        /// True if no digit repeats in a unit and every empty cell has a candidate
+        [[nodiscard]] SD_CONSTEXPR20 bool consistent() const noexcept {
+            for (index_type i = 0; i < cell_count; ++i) {
+                const cell_type &cell = cells_[i];
+                if (cell.isConfirmed() ? (placed_among_peers(i) & cell.possibleMask()) != 0 : cell.possibleMask() == 0)
+                    return false;
+            }
+            return true;
+        }
+
+        /// The grid as a board, ready for <code>solve()</code> or <code>triage()</code>
+        [[nodiscard]] SD_CONSTEXPR20 board_type board() const noexcept {
+            board_type board{};
+            board.cells = cells_;
+            board.sync_placement();
+            return board;
+        }
+
+    private:
+        [[nodiscard]] SD_CONSTEXPR20 mask_type placed_among_peers(const index_type cell) const noexcept {
+            mask_type placed = 0;
+            for (const index_type peer: board_type::tables().peers[cell])
+                if (cells_[peer].isConfirmed()) placed |= cells_[peer].possibleMask();
+            return placed;
+        }
+
+        [[nodiscard]] SD_CONSTEXPR20 mask_type open_candidates(const index_type cell) const noexcept {
+            return static_cast<mask_type>(board_type::full_mask & ~placed_among_peers(cell));
+        }
+
+        SD_CONSTEXPR20 void record(Update &update, const index_type cell) const noexcept {
+            const mask_type mask = cells_[cell].possibleMask();
+            update.changes[update.count++] = {cell, mask};
+            if (mask == 0) update.consistent = false;
+        }
+
+        SD_CONSTEXPR20 void refresh_peers(const index_type cell, Update &update) noexcept {
+            for (const index_type peer: board_type::tables().peers[cell]) {
+                cell_type &other = cells_[peer];
+                if (other.isConfirmed()) continue;
+                const mask_type mask = open_candidates(peer);
+                if (mask == other.state) continue;
+                other.state = mask;
+                record(update, peer);
+            }
+        }
+
+        array<cell_type, cell_count> cells_;
+    };
+
+    using CandidateGrid = BasicCandidateGrid<3, 3>;
+
+    static_assert(std::is_trivially_copyable<CandidateGrid>::value, "a candidate grid must be copyable as bytes");
+
+    // =========================
+    //   PUZZLE GENERATION
+    // =========================
+
+    namespace detail {
+        /**
+         * @brief SplitMix64: tiny seeded generator, so puzzles are reproducible from their seed.
+         */
+        struct Rng {
+            uint64_t state;
+
+            uint64_t next() noexcept {
+                uint64_t z = state += 0x9E3779B97F4A7C15ull;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                return z ^ (z >> 31);
+            }
+
+            /// Uniform value in [0, n)
+            uint32_t below(const uint32_t n) noexcept {
+                return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+            }
+
+            template<typename T>
+            void shuffle(T *items, const uint32_t n) noexcept {
+                for (uint32_t i = n; i > 1; --i) {
+                    const uint32_t j = below(i);
+                    const T tmp = items[i - 1];
+                    items[i - 1] = items[j];
+                    items[j] = tmp;
+                }
+            }
+        };
+
+        /**
+         * @brief Random complete grid: shuffled digits in the three diagonal boxes, completed by search.
+         */
+        inline bool random_grid(Board &grid, Rng &rng, SolverWorkspace &workspace) {
+            for (auto &cell: grid.cells) cell.state = 0b1111111110; // NOLINT for range-based for
+            for (uint8_t box = 0; box < 3; ++box) {
+                uint8_t digits[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+                rng.shuffle(digits, 9);
+                const uint8_t *group = unit_tables.units[18 + box * 4]; // boxes 0, 4 and 8 share no line
+                for (uint8_t i = 0; i < 9; ++i) grid.cells[group[i]].state = static_cast<uint16_t>(1u << digits[i] | 1u);
+            }
+            grid.sync_placement();
+            return solve(grid, workspace);
+        }
+    }
+
+    /**
+     * @brief Settings for <code>generate()</code>.
+     */
+    struct GenerateOptions {
+        uint64_t seed = 0;          ///< Same seed, same puzzle
+        uint8_t target_clues = 0;   ///< Stop removing clues at this count; 0 reduces to a minimal puzzle
+        bool symmetric = false;     ///< Remove clues in pairs symmetric under 180° rotation (an odd target may end one above)
+        uint32_t min_guesses = 0;   ///< Reject puzzles that <code>solve()</code> finishes in fewer guesses
+        uint32_t max_attempts = 16; ///< Grids tried before giving up on <code>min_guesses</code>
+    };
+
+    /**
+     * @brief Generate a puzzle with a unique solution.
+     *
+     * <p>
+     * A random complete grid is built first; clues are then removed in random
+     * order, each removal kept only if the puzzle still has exactly one solution
+     * (checked with <code>count_solutions(…, 2)</code>). Removal stops at
+     * <code>target_clues</code>, or when no clue can be removed any more; the
+     * result may therefore keep more clues than requested, but never fewer.
+     * Symmetric removal takes clues in mirrored pairs and only the centre
+     * alone, so it can skip a pair that would drop below the target. It then
+     * stops one clue above an odd target once the centre is gone. All searches
+     * run in the given workspace, so generation performs no heap allocation.
+     * </p>
+     *
+     * @param puzzle Receives the generated puzzle (givens confirmed, other cells open).
+     * @param options Seed, clue target, symmetry and difficulty floor.
+     * @param workspace Search memory, reused across calls.
+     * @param solution Optional; receives the unique solution.
+     * @return Number of clues of the puzzle, or 0 if no attempt met <code>min_guesses</code>.
+     */
+    inline uint8_t generate(Board &puzzle, const GenerateOptions &options, SolverWorkspace &workspace,
+                            Board *solution = nullptr) {
+        detail::Rng rng{options.seed};
+        const uint32_t attempts = options.min_guesses && options.max_attempts ? options.max_attempts : 1;
+
+        for (uint32_t attempt = 0; attempt < attempts; ++attempt) {
+            Board grid{};
+            if (!detail::random_grid(grid, rng, workspace)) continue;
+
+            uint8_t order[81];
+            for (uint8_t i = 0; i < 81; ++i) order[i] = i;
+            rng.shuffle(order, 81);
+
+            puzzle = grid;
+            uint8_t clues = 81;
+            for (uint8_t k = 0; k < 81 && clues > options.target_clues; ++k) {
+                const uint8_t idx = order[k];
+                const uint8_t mirror = static_cast<uint8_t>(80 - idx);
+                if (!puzzle.cells[idx].isConfirmed()) continue;
+                if (options.symmetric && mirror < idx) continue; // handled together with its partner
+                const bool pair = options.symmetric && mirror != idx;
+                if (pair && clues - 2 < options.target_clues) continue; // would overshoot; only the centre fits
+
+                const Board before = puzzle;
+                puzzle.cells[idx].state = 0b1111111110;
+                if (pair) puzzle.cells[mirror].state = 0b1111111110;
+                puzzle.sync_placement();
+                if (has_unique_solution(puzzle, workspace)) {
+                    clues = static_cast<uint8_t>(clues - (pair ? 2 : 1));
+                } else {
+                    puzzle = before;
+                }
+            }
+
+            if (options.min_guesses) {
+                Board probe = puzzle;
+                solve(probe, workspace);
+                if (workspace.nodes < options.min_guesses) continue;
+            }
+            if (solution) *solution = grid;
+            return clues;
+        }
+        return 0;
+    }
+
+    inline uint8_t generate(Board &puzzle, const GenerateOptions &options = GenerateOptions{}) {
+        return generate(puzzle, options, detail::default_workspace());
+    }
+
+    // =========================
+    //   STATUS CODES
+    // =========================
+
+    /**
+     * @brief Numeric outcome of solving one puzzle buffer.
+     * @note Values are identical to <code>sd_status_t</code> in <code>sd_c_api.h</code>.
+     */
+    enum class Status : uint8_t {
+        solved = 0,         ///< Solution written back to the buffer
+        invalid_size = 1,   ///< Buffer does not hold 81 cells
+        invalid_puzzle = 2, ///< Givens repeat a digit in a row, column or box
+        unsolvable = 3,     ///< Givens are consistent but admit no solution
+        limit_reached = 4   ///< Search stopped by a budget or cancellation before finishing
+    };
+
+    /**
+     * @brief Human-readable message for a status, as returned by <code>sudoku_solver()</code>.
+     * @return Static string, never <code>nullptr</code>.
+     */
+    [[nodiscard]] inline const char *status_message(const Status status) noexcept {
+        switch (status) {
+            case Status::solved: return "Solved";
+            case Status::invalid_size: return "Invalid size";
+            case Status::invalid_puzzle: return "Invalid puzzle";
+            case Status::unsolvable: return "No solution found";
+            case Status::limit_reached: return "Limit reached";
+        }
+        return "Unknown status";
     }
 
     /**
      * @brief Public API for external use.
      * @param puzzle Pointer to 81-element int8_t array (0 for empty, 1–9 for digits).
      * @param size Must be 81.
+     * @return <code>Status::solved</code> with <code>puzzle</code> overwritten, or the failure reason.
+     */
+    inline Status sudoku_solve(int8_t *puzzle, const uint64_t size) {
+        if (size != 81) return Status::invalid_size;
+        Board board{};
+        board.load_int8_t(puzzle);
+        if (!board.check_initial_valid()) return Status::invalid_puzzle;
+        if (!solve(board)) return Status::unsolvable;
+        for (uint8_t i = 0; i < 81; ++i) {
+            puzzle[i] = board.cells[i].getConfirmedValue();
+        }
+        return Status::solved;
+    }
+
+    /**
+     * @brief String form of <code>sudoku_solve()</code>, kept for existing callers.
+     * @param puzzle Pointer to 81-element int8_t array (0 for empty, 1–9 for digits).
+     * @param size Must be 81.
      * @return String indicating result ("Solved", "Invalid puzzle", etc.)
      */
     inline const char *sudoku_solver(int8_t *puzzle, const uint64_t size) {
-        if (size != 81) {
-            return "Invalid size";
+        return status_message(sudoku_solve(puzzle, size));
+    }
+
+    // =========================
+    //   BOUNDED SOLVING
+    // =========================
+
+    /**
+     * @brief Bounds on one search; a default-constructed value sets no bound.
+     *
+     * <p>
+     * The limits are checked every <code>detail::stop_poll_interval</code>
+     * guesses (64), so a check costs one comparison per guess and a clock read
+     * per 64 guesses. A search may therefore overrun <code>max_nodes</code> by
+     * fewer than 64 guesses, and <code>deadline</code> by the time those take
+     * (typically microseconds).
+     * </p>
+     */
+    struct SolveLimits {
+        using clock = std::chrono::steady_clock;
+
+        uint64_t max_nodes = 0;                                ///< Guess budget; 0 for none
+        clock::time_point deadline = clock::time_point::max(); ///< Give up after this instant; max() for none
+        const std::atomic<bool> *cancel = nullptr;             ///< Give up once it reads true
+
+        /// Limits with a deadline <code>timeout</code> from now
+        static SolveLimits within(const clock::duration timeout) {
+            SolveLimits limits{};
+            limits.deadline = clock::now() + timeout;
+            return limits;
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Stop condition enforcing a <code>SolveLimits</code>; remembers whether it fired.
+         */
+        struct LimitStop {
+            const SolveLimits &limits;
+            const uint64_t &nodes; ///< The workspace's guess counter
+            bool fired = false;
+
+            bool operator()() {
+                fired = (limits.max_nodes && nodes >= limits.max_nodes) ||
+                        (limits.cancel && limits.cancel->load(std::memory_order_relaxed)) ||
+                        (limits.deadline != SolveLimits::clock::time_point::max() &&
+                         SolveLimits::clock::now() >= limits.deadline);
+                return fired;
+            }
+        };
+    }
+
+    /**
+     * @brief Solve a board within the given node budget, deadline and cancel flag.
+     * @param board Board to solve (in-place).
+     * @param workspace Caller-owned search memory, reused across calls.
+     * @param options Engine, deduction level and branching strategy.
+     * @param limits Bounds of the search.
+     * @return <code>Status::solved</code>, <code>Status::unsolvable</code> if the
+     *         search space was exhausted, or <code>Status::limit_reached</code> if a
+     *         limit stopped it first (the board is then left as given).
+     */
+    inline Status solve(Board &board, SolverWorkspace &workspace, const SolveOptions &options,
+                        const SolveLimits &limits) {
+        detail::LimitStop stop{limits, workspace.nodes};
+        Board root = board;
+        detail::KeepFirst<Board> keep{board};
+        if (detail::search(root, workspace, options, stop, keep)) return Status::solved;
+        return stop.fired ? Status::limit_reached : Status::unsolvable;
+    }
+
+    // =========================
+    //   RESUMABLE SEARCH
+    // =========================
+
+    /**
+     * @brief A paused search: the copy engine's frame stack and its top, detached from any workspace.
+     *
+     * <p>
+     * Every frame owns a full board, so the state is self-contained and holds
+     * no pointers: it is trivially copyable and can be saved with
+     * <code>std::memcpy</code>, written to a file or handed to another worker,
+     * and resumed there without repeating any of the guesses already tried.
+     * It is as large as the copy engine's stack (about 18 KB for 9x9); keep it
+     * off the stack for large boards.
+     * </p>
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units = StandardUnits<BoxRows, BoxCols>>
+    struct BasicSearchState {
+        static constexpr uint16_t cell_count = detail::Geometry<BoxRows, BoxCols>::cell_count;
+
+        BasicFrame<BoxRows, BoxCols, Units> stack[cell_count]; ///< <code>stack[0].board</code> holds the puzzle until the first resume
+        typename detail::Geometry<BoxRows, BoxCols>::signed_index top; ///< Deepest frame; -1 once the tree is exhausted
+        bool started;                                   ///< The root has been propagated and seeded
+        uint64_t nodes;                                 ///< Guesses tried over all resumes
+
+        /// true once every branch has been tried; further resumes return <code>Status::unsolvable</code>
+        [[nodiscard]] constexpr bool exhausted() const noexcept { return started && top < 0; }
+    };
+
+    using SearchState = BasicSearchState<3, 3>;
+
+    static_assert(std::is_trivially_copyable<SearchState>::value, "a search state must be copyable as bytes");
+
+    /**
+     * @brief Set <code>state</code> up to search <code>puzzle</code>; nothing is solved until the first resume.
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    SD_CONSTEXPR20 void start_search(BasicSearchState<BoxRows, BoxCols, Units> &state,
+                                     const BasicBoard<BoxRows, BoxCols, Units> &puzzle) noexcept {
+        state.stack[0].board = puzzle;
+        state.top = 0;
+        state.started = false;
+        state.nodes = 0;
+    }
+
+    /**
+     * @brief Continue a search until its next solution, the end of the tree or one of <code>limits</code>.
+     *
+     * <p>
+     * The search always runs the copy engine, whatever <code>options.engine</code>
+     * says; the deduction level and branching strategy may differ from one
+     * resume to the next. <code>limits.max_nodes</code> counts the guesses of
+     * this call only.
+     * </p>
+     *
+     * @param state Search to continue, from <code>start_search()</code> or an earlier resume.
+     * @param solution Receives the solution when one is found.
+     * @param options Deduction level and branching strategy.
+     * @param limits Bounds of this call.
+     * @return <code>Status::solved</code> (resume again for the next solution),
+     *         <code>Status::limit_reached</code> (paused; resume again to go on) or
+     *         <code>Status::unsolvable</code> (no further solution exists).
+     */
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    Status resume_search(BasicSearchState<BoxRows, BoxCols, Units> &state, BasicBoard<BoxRows, BoxCols, Units> &solution,
+                         const SolveOptions &options = SolveOptions{}, const SolveLimits &limits = SolveLimits{}) {
+        using board_type = BasicBoard<BoxRows, BoxCols, Units>;
+        detail::NoStats stats;
+        if (!state.started) {
+            state.started = true;
+            board_type &root = state.stack[0].board;
+            detail::NoTrail none;
+            if (!root.propagate_all(none, options.deduction)) { // invalid
+                state.top = -1;
+                return Status::unsolvable;
+            }
+            const auto branch = detail::pick_branch(root, options.branching);
+            if (branch.target == -1) { // already solved
+                solution = root;
+                state.top = -1;
+                return Status::solved;
+            }
+            state.stack[0].target_idx = static_cast<typename board_type::index_type>(branch.target);
+            state.stack[0].digit = branch.digit;
+            state.stack[0].remaining_mask = branch.mask;
+        }
+
+        uint64_t nodes = 0;
+        detail::LimitStop stop{limits, nodes};
+        detail::KeepFirst<board_type> keep{solution};
+        const bool found = detail::run_copy(state.stack, state.top, nodes, options, stop, keep, stats);
+        state.nodes += nodes;
+        if (found) return Status::solved;
+        return stop.fired ? Status::limit_reached : Status::unsolvable;
+    }
+
+    // =========================
+    //   BATCH SOLVING
+    // =========================
+
+    /**
+     * @brief Solve one 81-cell puzzle buffer in place.
+     * @param puzzle Pointer to 81-element int8_t array (0 for empty, 1–9 for digits).
+     * @param workspace Search memory, reused across calls.
+     * @param options Engine, deduction level and branching strategy.
+     * @return <code>Status::solved</code> with <code>puzzle</code> overwritten, or the failure reason.
+     */
+    inline Status solve_puzzle(int8_t *puzzle, SolverWorkspace &workspace,
+                               const SolveOptions &options = SolveOptions{}) {
+        Board board{};
+        board.load_int8_t(puzzle);
+        if (!board.check_initial_valid()) return Status::invalid_puzzle;
+        if (!solve(board, workspace, options)) return Status::unsolvable;
+        for (uint8_t i = 0; i < 81; ++i) puzzle[i] = board.cells[i].getConfirmedValue();
+        return Status::solved;
+    }
+
+    /**
+     * @brief <code>solve_puzzle()</code> bounded by <code>limits</code>.
+     * @return As the unbounded overload, or <code>Status::limit_reached</code>
+     *         with <code>puzzle</code> unchanged if a limit stopped the search.
+     */
+    inline Status solve_puzzle(int8_t *puzzle, SolverWorkspace &workspace, const SolveOptions &options,
+                               const SolveLimits &limits) {
+        Board board{};
+        board.load_int8_t(puzzle);
+        if (!board.check_initial_valid()) return Status::invalid_puzzle;
+        const Status status = solve(board, workspace, options, limits);
+        if (status != Status::solved) return status;
+        for (uint8_t i = 0; i < 81; ++i) puzzle[i] = board.cells[i].getConfirmedValue();
+        return Status::solved;
+    }
+
+    /**
+     * @brief <code>solve_puzzle()</code> that also reports what the search did.
+     * @param stats Overwritten with the search counters; all zero if the givens are rejected.
+     */
+    inline Status solve_puzzle(int8_t *puzzle, SolverWorkspace &workspace, const SolveOptions &options,
+                               SolveStats &stats) {
+        stats = SolveStats{};
+        Board board{};
+        board.load_int8_t(puzzle);
+        if (!board.check_initial_valid()) return Status::invalid_puzzle;
+        if (!solve(board, workspace, options, stats)) return Status::unsolvable;
+        for (uint8_t i = 0; i < 81; ++i) puzzle[i] = board.cells[i].getConfirmedValue();
+        return Status::solved;
+    }
+
+    /**
+     * @brief Solve a contiguous array of puzzles in place with a single workspace.
+     * @param puzzles <code>count</code> consecutive 81-cell buffers.
+     * @param count Number of puzzles.
+     * @param statuses Optional output, one entry per puzzle (may be <code>nullptr</code>).
+     * @param workspace Search memory shared by the whole batch.
+     * @param options Engine, deduction level and branching strategy.
+     * @return Number of puzzles solved.
+     */
+    inline std::size_t solve_batch(int8_t *puzzles, const std::size_t count, Status *statuses,
+                                   SolverWorkspace &workspace, const SolveOptions &options = SolveOptions{}) {
+        std::size_t solved = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Status status = solve_puzzle(puzzles + i * 81, workspace, options);
+            solved += status == Status::solved;
+            if (statuses) statuses[i] = status;
+        }
+        return solved;
+    }
+
+    /**
+     * @brief Batch solve using the calling thread's default workspace.
+     */
+    inline std::size_t solve_batch(int8_t *puzzles, const std::size_t count, Status *statuses) {
+        return solve_batch(puzzles, count, statuses, detail::default_workspace());
+    }
+
+    // =========================
+    //   PACKED FORMAT
+    // =========================
+
+    /**
+     * @brief Bytes of one packed puzzle: 81 cells at 4 bits each.
+     *
+     * <p>
+     * Cell <code>i</code> lives in byte <code>i / 2</code>, even cells in the low
+     * nibble and odd cells in the high one (the last high nibble is zero);
+     * 0 is an empty cell and 1–9 a digit. Half the size of an
+     * <code>int8_t</code> buffer and of an 82-byte text line.
+     * </p>
+     */
+    inline constexpr std::size_t packed_size = 41;
+
+    namespace detail {
+        /// Nibble to cell state; 10–15 decode to 0 so malformed input is detected on the way
+        inline constexpr uint16_t packed_states[16] = {
+            0b1111111110, 0b11, 0b101, 0b1001, 0b10001, 0b100001, 0b1000001, 0b10000001,
+            0b100000001, 0b1000000001, 0, 0, 0, 0, 0, 0
+        };
+
+        /// Cell state to nibble: the digit of a confirmed cell, 0 otherwise
+        inline uint8_t packed_digit(const SudokuCell &cell) noexcept {
+            return static_cast<uint8_t>(cell.getConfirmedValue());
+        }
+    }
+
+    /**
+     * @brief Encode a board's confirmed cells into <code>packed_size</code> bytes.
+     */
+    inline void pack(const Board &board, uint8_t *out) noexcept {
+        for (uint8_t i = 0; i < 40; ++i) {
+            out[i] = static_cast<uint8_t>(detail::packed_digit(board.cells[i * 2]) |
+                                          detail::packed_digit(board.cells[i * 2 + 1]) << 4);
         }
+        out[40] = detail::packed_digit(board.cells[80]);
+    }
+
+    /**
+     * @brief Decode <code>packed_size</code> bytes straight into cell masks.
+     * @return false if a nibble is outside 0–9 (the board is then not usable).
+     */
+    inline bool unpack(const uint8_t *in, Board &board) noexcept {
+        uint16_t malformed = 0;
+        for (uint8_t i = 0; i < 40; ++i) {
+            const uint16_t low = detail::packed_states[in[i] & 0xF];
+            const uint16_t high = detail::packed_states[in[i] >> 4];
+            board.cells[i * 2].state = low;
+            board.cells[i * 2 + 1].state = high;
+            malformed |= static_cast<uint16_t>(!low | !high);
+        }
+        board.cells[80].state = detail::packed_states[in[40] & 0xF];
+        malformed |= static_cast<uint16_t>((board.cells[80].state == 0) | (in[40] >> 4));
+        if (malformed) return false;
+        board.sync_placement();
+        return true;
+    }
+
+    /**
+     * @brief Convert an 81-cell <code>int8_t</code> buffer to the packed format.
+     */
+    inline void pack_int8_t(const int8_t *puzzle, uint8_t *out) noexcept {
+        auto digit = [](const int8_t v) { return static_cast<uint8_t>(v >= 1 && v <= 9 ? v : 0); };
+        for (uint8_t i = 0; i < 40; ++i) out[i] = static_cast<uint8_t>(digit(puzzle[i * 2]) | digit(puzzle[i * 2 + 1]) << 4);
+        out[40] = digit(puzzle[80]);
+    }
+
+    /**
+     * @brief Convert a packed puzzle to an 81-cell <code>int8_t</code> buffer (nibbles above 9 become 0).
+     */
+    inline void unpack_int8_t(const uint8_t *in, int8_t *puzzle) noexcept {
+        auto digit = [](const uint8_t v) { return static_cast<int8_t>(v <= 9 ? v : 0); };
+        for (uint8_t i = 0; i < 40; ++i) {
+            puzzle[i * 2] = digit(in[i] & 0xF);
+            puzzle[i * 2 + 1] = digit(in[i] >> 4);
+        }
+        puzzle[80] = digit(in[40] & 0xF);
+    }
+
+    /**
+     * @brief Solve one packed puzzle in place.
+     * @return <code>Status::solved</code> with <code>puzzle</code> overwritten, or the failure reason
+     *         (a malformed nibble is <code>Status::invalid_puzzle</code>).
+     */
+    inline Status solve_packed(uint8_t *puzzle, SolverWorkspace &workspace,
+                               const SolveOptions &options = SolveOptions{}) {
         Board board{};
-        try {
-            board.load_int8_t(puzzle);
-        } catch (const std::exception &) {
-            return "Size mismatch with declared size";
+        if (!unpack(puzzle, board) || !board.check_initial_valid()) return Status::invalid_puzzle;
+        if (!solve(board, workspace, options)) return Status::unsolvable;
+        pack(board, puzzle);
+        return Status::solved;
+    }
+
+    /**
+     * @brief Solve a contiguous array of packed puzzles in place with a single workspace.
+     * @param puzzles <code>count</code> consecutive <code>packed_size</code>-byte records.
+     * @param count Number of puzzles.
+     * @param statuses Optional output, one entry per puzzle (may be <code>nullptr</code>).
+     * @param workspace Search memory shared by the whole batch.
+     * @param options Engine, deduction level and branching strategy.
+     * @return Number of puzzles solved.
+     */
+    inline std::size_t solve_batch_packed(uint8_t *puzzles, const std::size_t count, Status *statuses,
+                                          SolverWorkspace &workspace, const SolveOptions &options = SolveOptions{}) {
+        std::size_t solved = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Status status = solve_packed(puzzles + i * packed_size, workspace, options);
+            solved += status == Status::solved;
+            if (statuses) statuses[i] = status;
         }
-        if (!board.check_initial_valid()) {
-            return "Invalid puzzle";
+        return solved;
+    }
+
+#if SD_ENABLE_THREADS
+    // =========================
+    //   PARALLEL BATCH SOLVING
+    // =========================
+
+    /**
+     * @brief Scheduling knobs for the parallel batch solver.
+     */
+    struct ParallelOptions {
+        unsigned threads = 0;   ///< Worker count; 0 uses <code>std::thread::hardware_concurrency()</code>
+        std::size_t chunk = 16; ///< Puzzles a worker claims at a time (0 is treated as 1)
+        unsigned split = 8;     ///< Parallel search: independent subtrees opened per worker
+        SolveOptions solve{};   ///< Per-puzzle solver settings
+    };
+
+    namespace detail {
+        /**
+         * @brief Run <code>fn(begin, end, workspace)</code> over <code>[0, count)</code> on a set of workers.
+         *
+         * <p>
+         * Work is handed out dynamically: each worker repeatedly claims the next
+         * <code>chunk</code> items from a shared atomic counter, so a few very hard
+         * puzzles never leave the other cores idle. The calling thread is one of
+         * the workers, and every worker searches with its own workspace. If a
+         * thread cannot be started, the remaining workers absorb its share.
+         * </p>
+         */
+        template<typename Fn>
+        void parallel_chunks(const std::size_t count, const ParallelOptions &options, Fn &&fn) {
+            const std::size_t chunk = options.chunk ? options.chunk : 1;
+            unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+            if (threads == 0) threads = 1;
+            const std::size_t chunks = (count + chunk - 1) / chunk;
+            if (chunks < threads) threads = static_cast<unsigned>(chunks ? chunks : 1);
+
+            std::atomic<std::size_t> next{0};
+            auto worker = [&]() {
+                SolverWorkspace &workspace = default_workspace();
+                while (true) {
+                    const std::size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+                    if (begin >= count) return;
+                    fn(begin, std::min(begin + chunk, count), workspace);
+                }
+            };
+
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; ++t) {
+                try {
+                    pool.emplace_back(worker);
+                } catch (const std::system_error &) {
+                    break;
+                }
+            }
+            worker();
+            for (auto &thread: pool) thread.join();
         }
-        if (solve(board)) {
-            for (uint8_t i = 0; i < 81; ++i) {
-                puzzle[i] = board.cells[i].getConfirmedValue();
+    }
+
+    /**
+     * @brief Solve a contiguous array of puzzle buffers in place on several threads.
+     * @param puzzles <code>count</code> consecutive 81-cell buffers.
+     * @param count Number of puzzles.
+     * @param statuses Optional output, one entry per puzzle (may be <code>nullptr</code>).
+     * @param options Thread count, chunk size and solver settings.
+     * @return Number of puzzles solved.
+     */
+    inline std::size_t solve_batch_parallel(int8_t *puzzles, const std::size_t count, Status *statuses,
+                                            const ParallelOptions &options = ParallelOptions{}) {
+        std::atomic<std::size_t> solved{0};
+        detail::parallel_chunks(count, options, [&](const std::size_t begin, const std::size_t end,
+                                                    SolverWorkspace &workspace) {
+            solved.fetch_add(solve_batch(puzzles + begin * 81, end - begin, statuses ? statuses + begin : nullptr,
+                                         workspace, options.solve), std::memory_order_relaxed);
+        });
+        return solved.load();
+    }
+
+    /**
+     * @brief Solve a span of boards in place on several threads.
+     * @param boards <code>count</code> boards.
+     * @param count Number of boards.
+     * @param statuses Optional output: <code>Status::solved</code> or <code>Status::unsolvable</code>.
+     * @param options Thread count, chunk size and solver settings.
+     * @return Number of boards solved.
+     */
+    inline std::size_t solve_parallel(Board *boards, const std::size_t count, Status *statuses,
+                                      const ParallelOptions &options = ParallelOptions{}) {
+        std::atomic<std::size_t> solved{0};
+        detail::parallel_chunks(count, options, [&](const std::size_t begin, const std::size_t end,
+                                                    SolverWorkspace &workspace) {
+            std::size_t local = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                const bool ok = solve(boards[i], workspace, options.solve);
+                local += ok;
+                if (statuses) statuses[i] = ok ? Status::solved : Status::unsolvable;
+            }
+            solved.fetch_add(local, std::memory_order_relaxed);
+        });
+        return solved.load();
+    }
+
+    /**
+     * @brief Solve a contiguous array of packed puzzles in place on several threads.
+     * @param puzzles <code>count</code> consecutive <code>packed_size</code>-byte records.
+     * @param count Number of puzzles.
+     * @param statuses Optional output, one entry per puzzle (may be <code>nullptr</code>).
+     * @param options Thread count, chunk size and solver settings.
+     * @return Number of puzzles solved.
+     */
+    inline std::size_t solve_batch_packed_parallel(uint8_t *puzzles, const std::size_t count, Status *statuses,
+                                                   const ParallelOptions &options = ParallelOptions{}) {
+        std::atomic<std::size_t> solved{0};
+        detail::parallel_chunks(count, options, [&](const std::size_t begin, const std::size_t end,
+                                                    SolverWorkspace &workspace) {
+            solved.fetch_add(solve_batch_packed(puzzles + begin * packed_size, end - begin,
+                                                statuses ? statuses + begin : nullptr, workspace, options.solve),
+                             std::memory_order_relaxed);
+        });
+        return solved.load();
+    }
+
+    // =========================
+    //   PARALLEL SEARCH
+    // =========================
+
+    /**
+     * @brief Solve one hard puzzle by splitting its search tree across threads.
+     *
+     * <p>
+     * The first branching levels are expanded breadth-first until about
+     * <code>threads * split</code> independent subtrees are open. Workers then
+     * claim subtrees one at a time and search each with their own workspace and
+     * the configured engine. The first worker to find a solution raises a shared
+     * flag; every other search polls it and abandons its subtree.
+     * </p>
+     *
+     * <p>
+     * Lowers tail latency on pathological grids; easy puzzles are usually solved
+     * while the tree is being split, without starting any thread.
+     * </p>
+     *
+     * @param root Board to solve (in-place).
+     * @param options Thread count, split factor and solver settings (<code>chunk</code> is ignored).
+     * @return true if solved, false otherwise.
+     */
+    inline bool solve_parallel_search(Board &root, const ParallelOptions &options = ParallelOptions{}) {
+        const SolveOptions &solve_options = options.solve;
+        detail::NoTrail none;
+        if (!root.propagate_all(none, solve_options.deduction)) return false;
+        if (root.confirmed_count == 81) return true;
+
+        unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        const std::size_t target = static_cast<std::size_t>(threads) * (options.split ? options.split : 1);
+
+        // Breadth-first split; frontier[head..] are the open subtrees
+        std::vector<Board> frontier(1, root);
+        std::size_t head = 0;
+        while (head < frontier.size() && frontier.size() - head < target) {
+            const Board node = frontier[head++];
+            const detail::Branch branch = detail::pick_branch(node, solve_options.branching);
+            for (uint16_t mask = branch.mask; mask; mask &= mask - 1) {
+                Board next = node;
+                if (!detail::take_branch(next, static_cast<uint8_t>(branch.target), branch.digit,
+                                         static_cast<uint16_t>(mask & -mask), none, solve_options.deduction))
+                    continue;
+                if (next.confirmed_count == 81) {
+                    root = next;
+                    return true;
+                }
+                frontier.push_back(next);
             }
-            return "Solved";
         }
-        return "No solution found";
+        if (head == frontier.size()) return false; // the whole tree was refuted while splitting
+
+        std::atomic<bool> found{false};
+        ParallelOptions scheduling = options;
+        scheduling.threads = threads;
+        scheduling.chunk = 1;
+        detail::parallel_chunks(frontier.size() - head, scheduling, [&](const std::size_t begin, const std::size_t end,
+                                                                        SolverWorkspace &workspace) {
+            auto stop = [&found]() { return found.load(std::memory_order_relaxed); };
+            for (std::size_t i = begin; i < end && !stop(); ++i) {
+                Board &board = frontier[head + i];
+                detail::KeepFirst<Board> keep{board};
+                const bool ok = detail::search(board, workspace, solve_options, stop, keep);
+                bool expected = false;
+                if (ok && found.compare_exchange_strong(expected, true)) root = board;
+            }
+        });
+        return found.load();
     }
-}
\ No newline at end of file
+#endif
+SD_END_NAMESPACE
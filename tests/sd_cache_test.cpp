@@ -0,0 +1,142 @@
+/**
+ * @file sd_cache_test.cpp
+ * @brief <code>canonicalize()</code> and <code>SolutionCache</code>: isomorphic puzzles share a key and an answer.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <set>
+#include <utility>
+
+#include "sd_cache.hpp"
+#include "sd_test.hpp"
+
+namespace {
+    /// A random element of the symmetry group: bands, rows within bands, stacks, columns, digits, transposition
+    sd::Transform random_transform(std::mt19937 &rng) {
+        sd::Transform t{};
+        t.transpose = rng() & 1;
+        for (uint8_t *lines: {t.rows, t.cols}) {
+            uint8_t groups[3] = {0, 1, 2};
+            std::shuffle(groups, groups + 3, rng);
+            for (uint8_t g = 0; g < 3; ++g) {
+                uint8_t within[3] = {0, 1, 2};
+                std::shuffle(within, within + 3, rng);
+                for (uint8_t k = 0; k < 3; ++k) lines[g * 3 + k] = static_cast<uint8_t>(groups[g] * 3 + within[k]);
+            }
+        }
+        for (uint8_t d = 0; d < 10; ++d) t.digits[d] = d;
+        std::shuffle(t.digits + 1, t.digits + 10, rng);
+        return t;
+    }
+
+    void grid_of(const std::string &line, int8_t *grid) {
+        for (uint8_t i = 0; i < 81; ++i)
+            grid[i] = static_cast<int8_t>(line[i] >= '1' && line[i] <= '9' ? line[i] - '0' : 0);
+    }
+
+    sd::Board board_of(const int8_t *grid) {
+        sd::Board board{};
+        board.load_int8_t(grid);
+        return board;
+    }
+
+    /// The canonical transform maps the puzzle onto the canonical grid and back
+    void check_transform(const int8_t *puzzle, const sd::Canonical &canonical) {
+        int8_t image[81], back[81];
+        canonical.transform.apply(puzzle, image);
+        SD_CHECK(std::memcmp(image, canonical.grid, 81) == 0);
+        canonical.transform.restore(image, back);
+        SD_CHECK(std::memcmp(back, puzzle, 81) == 0);
+    }
+
+    /// Solve through the cache and check the answer solves <code>puzzle</code> and keeps its givens
+    void check_answer(sd::SolutionCache &cache, const int8_t *puzzle, sd::SolverWorkspace &workspace) {
+        int8_t grid[81];
+        std::memcpy(grid, puzzle, 81);
+        SD_CHECK(cache.solve_puzzle(grid, workspace) == sd::Status::solved);
+        SD_CHECK(sd_test::is_solution_of(board_of(grid), board_of(puzzle)));
+    }
+}
+
+int main() {
+    static sd::SolverWorkspace workspace{};
+    std::mt19937 rng(2025);
+    sd::SolutionCache cache;
+    std::size_t exact = 0, total = 0;
+
+    // 17clue.txt and hardest.txt are isomorphs of 20 and 8 puzzles, so their classes collapse to that many keys
+    for (const auto &[name, classes]: {std::pair<const char *, std::size_t>{"easy.txt", 100}, {"17clue.txt", 20},
+                                       {"hardest.txt", 8}}) {
+        std::set<std::string> keys;
+        for (const std::string &line: sd_test::corpus(name, 100)) {
+            int8_t puzzle[81], permuted[81];
+            grid_of(line, puzzle);
+            random_transform(rng).apply(puzzle, permuted);
+
+            const sd::Canonical a = sd::canonicalize(puzzle);
+            const sd::Canonical b = sd::canonicalize(permuted);
+            check_transform(puzzle, a);
+            check_transform(permuted, b);
+            ++total;
+            if (a.exact && b.exact) {
+                ++exact;
+                SD_CHECK(std::memcmp(a.grid, b.grid, 81) == 0);
+                keys.emplace(reinterpret_cast<const char *>(a.grid), 81);
+            }
+
+            // A miss (or an isomorph of an earlier puzzle), an exact repeat, then a copy answered through restore()
+            const sd::CacheStats before = cache.stats();
+            check_answer(cache, puzzle, workspace);
+            check_answer(cache, puzzle, workspace);
+            const sd::CacheStats repeat = cache.stats();
+            SD_CHECK(repeat.misses + repeat.isomorphic_hits == before.misses + before.isomorphic_hits + 1);
+            SD_CHECK(repeat.hits == before.hits + 1);
+
+            int8_t cached[81];
+            std::memcpy(cached, permuted, 81);
+            SD_CHECK(cache.solve_puzzle(cached, workspace) == sd::Status::solved);
+            sd::Board solved = board_of(permuted);
+            SD_CHECK(sd::solve(solved, workspace));
+            for (uint8_t i = 0; i < 81; ++i) SD_CHECK(cached[i] == solved.cells[i].getConfirmedValue());
+            if (a.exact && b.exact) SD_CHECK(cache.stats().isomorphic_hits == repeat.isomorphic_hits + 1);
+        }
+        SD_CHECK(keys.size() <= classes);
+    }
+    SD_CHECK(exact * 10 >= total * 9); // corpus puzzles rarely tie past the limit
+
+    // Past the tie limit: the result is marked inexact but is still an image of the puzzle
+    for (const std::string &line: {std::string(81, '.'), "5" + std::string(80, '.'),
+                                   "1" + std::string(39, '.') + "2" + std::string(40, '.')}) {
+        int8_t puzzle[81], permuted[81];
+        grid_of(line, puzzle);
+        random_transform(rng).apply(puzzle, permuted);
+        for (const int8_t *grid: {+puzzle, +permuted}) {
+            const sd::Canonical canonical = sd::canonicalize(grid);
+            SD_CHECK(!canonical.exact);
+            check_transform(grid, canonical);
+            check_answer(cache, grid, workspace);
+            check_answer(cache, grid, workspace);
+        }
+    }
+
+    // Unsolvable puzzles are cached as such; invalid ones are rejected before the cache
+    int8_t puzzle[81];
+    grid_of("12345678." "........9" + std::string(63, '.'), puzzle); // cell 8 of row 0 has no digit left
+    const sd::CacheStats before = cache.stats();
+    int8_t grid[81];
+    for (int round = 0; round < 2; ++round) {
+        std::memcpy(grid, puzzle, 81);
+        SD_CHECK(cache.solve_puzzle(grid, workspace) == sd::Status::unsolvable);
+        SD_CHECK(std::memcmp(grid, puzzle, 81) == 0);
+    }
+    SD_CHECK(cache.stats().misses == before.misses + 1);
+    grid[1] = 1;
+    SD_CHECK(cache.solve_puzzle(grid, workspace) == sd::Status::invalid_puzzle);
+
+    cache.clear();
+    const sd::CacheStats cleared = cache.stats();
+    SD_CHECK(cleared.hits == 0 && cleared.isomorphic_hits == 0 && cleared.misses == 0);
+    return sd_test::finish();
+}
@@ -0,0 +1,37 @@
+/**
+ * @file sd_generate_test.cpp
+ * @brief <code>sd::generate()</code>: clue targets, symmetry and uniqueness.
+ */
+
+#include "sd_test.hpp"
+
+int main() {
+    static sd::SolverWorkspace workspace{};
+    for (uint64_t seed = 1; seed <= 12; ++seed) {
+        for (const uint8_t target: {27, 28, 31}) {
+            for (const bool symmetric: {false, true}) {
+                sd::GenerateOptions options{};
+                options.seed = seed;
+                options.target_clues = target;
+                options.symmetric = symmetric;
+                sd::Board puzzle{}, solution{};
+                const uint8_t clues = sd::generate(puzzle, options, workspace, &solution);
+
+                uint8_t confirmed = 0;
+                for (const auto &cell: puzzle.cells) confirmed += cell.isConfirmed();
+                SD_CHECK(clues == confirmed);
+                SD_CHECK(clues >= target); // symmetric pairs must not overshoot an odd target
+                SD_CHECK(sd::has_unique_solution(puzzle, workspace));
+                SD_CHECK(sd_test::is_solution_of(solution, puzzle));
+                if (symmetric)
+                    for (uint8_t i = 0; i < 81; ++i)
+                        SD_CHECK(puzzle.cells[i].isConfirmed() == puzzle.cells[80 - i].isConfirmed());
+
+                sd::Board again{};
+                SD_CHECK(sd::generate(again, options, workspace) == clues);
+                for (uint8_t i = 0; i < 81; ++i) SD_CHECK(again.cells[i].state == puzzle.cells[i].state);
+            }
+        }
+    }
+    return sd_test::finish();
+}
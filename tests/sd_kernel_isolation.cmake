@@ -0,0 +1,117 @@
+# Fails if code built for a newer CPU is reachable from the baseline kernel of libsudoklite.
+#
+#   cmake -DOBJDUMP=<objdump> -DLIBRARY=<libsudoklite.so> -P sd_kernel_isolation.cmake
+#
+# Every kernel instantiates the same standard-library inline code and the linker
+# keeps one copy of each for the whole library. Starting from the table
+# kernel_baseline, this follows direct calls and jumps, RIP-relative references
+# (function pointers, vtables, tables) and the pointers relocated into any data
+# it reaches, and reports every function on the way that holds an AVX, AVX-512,
+# BMI or POPCNT instruction. tzcnt is allowed: GCC emits it as rep bsf, which
+# older CPUs run as bsf.
+
+cmake_minimum_required(VERSION 3.14)
+
+set(table _ZN9sudoklite15kernel_baselineE)
+set(newer_isa "^(v[a-z0-9]+|k[a-z0-9]+|andn|bextr|blsi|blsmsk|blsr|bzhi|pdep|pext|rorx|sarx|shlx|shrx|popcnt|lzcnt)( |$)|%[yz]mm|%k[0-7]")
+
+function(run_objdump out)
+    execute_process(COMMAND ${OBJDUMP} ${ARGN} ${LIBRARY} OUTPUT_VARIABLE text RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${OBJDUMP} ${ARGN} failed on ${LIBRARY}")
+    endif ()
+    string(REGEX REPLACE "[][;]" "_" text "${text}") # keep every line one list element
+    string(REPLACE "\n" ";" text "${text}")
+    set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+# Symbols keyed by their address (lower-case hex without leading zeros)
+run_objdump(symbols -t)
+foreach (line IN LISTS symbols)
+    # Thread-local symbols are skipped: their values are offsets, not addresses
+    if (line MATCHES "^0*([0-9a-f]+) ....... ([^\t ]+)\t0*([0-9a-f]+)[ \t]+(.+)$"
+            AND NOT CMAKE_MATCH_2 STREQUAL ".tbss" AND NOT CMAKE_MATCH_2 STREQUAL ".tdata")
+        set(name_${CMAKE_MATCH_1} "${CMAKE_MATCH_4}")
+        set(size_${CMAKE_MATCH_1} "${CMAKE_MATCH_3}")
+        if (CMAKE_MATCH_4 STREQUAL table)
+            set(start ${CMAKE_MATCH_1})
+        endif ()
+    endif ()
+endforeach ()
+if (NOT start)
+    message(FATAL_ERROR "${LIBRARY} has no symbol ${table}; is it stripped?")
+endif ()
+
+# Pointers the loader relocates: "offset=target", offsets in decimal for range checks
+run_objdump(relocations -R)
+set(pointers)
+foreach (line IN LISTS relocations)
+    if (line MATCHES "^([0-9a-f]+) R_X86_64_RELATIVE +\\*ABS\\*\\+0x0*([0-9a-f]+)$")
+        math(EXPR offset "0x${CMAKE_MATCH_1}")
+        list(APPEND pointers "${offset}=${CMAKE_MATCH_2}")
+    endif ()
+endforeach ()
+
+# Per function: the addresses it references and its first newer-CPU instruction
+run_objdump(code -d --no-show-raw-insn)
+foreach (line IN LISTS code)
+    if (line MATCHES "^0*([0-9a-f]+) <(.+)>:$")
+        set(function ${CMAKE_MATCH_1})
+        set(function_name "${CMAKE_MATCH_2}")
+        set(refs_${function})
+        set(kind_${function} code)
+    elseif (function AND line MATCHES "^ +[0-9a-f]+:\t(.*)$")
+        set(instruction "${CMAKE_MATCH_1}")
+        if (NOT DEFINED isa_${function} AND instruction MATCHES "${newer_isa}")
+            set(isa_${function} "${instruction}")
+        endif ()
+        if (instruction MATCHES "([0-9a-f]+) <([^>]+)>$" AND NOT CMAKE_MATCH_2 STREQUAL function_name)
+            set(target ${CMAKE_MATCH_1})
+            if (CMAKE_MATCH_2 MATCHES "\\+0x([0-9a-f]+)$") # inside a symbol: reference its start
+                math(EXPR target "0x${target} - 0x${CMAKE_MATCH_1}" OUTPUT_FORMAT HEXADECIMAL)
+                string(REGEX REPLACE "^0x0*" "" target "${target}")
+                string(TOLOWER "${target}" target)
+            endif ()
+            list(APPEND refs_${function} ${target})
+        endif ()
+    endif ()
+endforeach ()
+
+set(queue ${start})
+set(seen ${start})
+set(newer)
+while (queue)
+    list(GET queue 0 at)
+    list(REMOVE_AT queue 0)
+    if (DEFINED kind_${at})
+        if (DEFINED isa_${at})
+            list(APPEND newer "  ${name_${at}}: ${isa_${at}}")
+        endif ()
+        set(targets ${refs_${at}})
+    else () # data: every pointer relocated into it
+        set(targets)
+        math(EXPR first "0x${at}")
+        math(EXPR last "${first} + 0x${size_${at}}")
+        foreach (pointer IN LISTS pointers)
+            string(REPLACE "=" ";" pointer "${pointer}")
+            list(GET pointer 0 offset)
+            if (offset GREATER_EQUAL first AND offset LESS last)
+                list(GET pointer 1 target)
+                list(APPEND targets ${target})
+            endif ()
+        endforeach ()
+    endif ()
+    foreach (target IN LISTS targets)
+        if (DEFINED name_${target} AND NOT target IN_LIST seen)
+            list(APPEND seen ${target})
+            list(APPEND queue ${target})
+        endif ()
+    endforeach ()
+endwhile ()
+
+list(LENGTH seen reached)
+if (newer)
+    string(REPLACE ";" "\n" newer "${newer}")
+    message(FATAL_ERROR "${table} reaches code built for a newer CPU:\n${newer}")
+endif ()
+message(STATUS "${table}: ${reached} symbols reached, none built for a newer CPU")
@@ -0,0 +1,78 @@
+/**
+ * @file sd_packed_test.cpp
+ * @brief The 41-byte packed format: round trips over the corpora and rejection of malformed nibbles.
+ */
+
+#include <cstring>
+
+#include "sd_test.hpp"
+
+namespace {
+    bool same_cells(const sd::Board &a, const sd::Board &b) {
+        for (uint8_t i = 0; i < 81; ++i)
+            if (a.cells[i].state != b.cells[i].state) return false;
+        return true;
+    }
+
+    void check_round_trip(const sd::Board &board) {
+        uint8_t packed[sd::packed_size];
+        sd::pack(board, packed);
+        SD_CHECK((packed[40] >> 4) == 0);
+        sd::Board back{};
+        SD_CHECK(sd::unpack(packed, back));
+        SD_CHECK(same_cells(back, board));
+
+        int8_t digits[81];
+        sd::unpack_int8_t(packed, digits);
+        for (uint8_t i = 0; i < 81; ++i)
+            SD_CHECK(digits[i] == static_cast<int8_t>(board.cells[i].getConfirmedValue()));
+        uint8_t repacked[sd::packed_size];
+        sd::pack_int8_t(digits, repacked);
+        SD_CHECK(std::memcmp(packed, repacked, sd::packed_size) == 0);
+    }
+}
+
+int main() {
+    static sd::SolverWorkspace workspace{};
+    for (const char *name: {"easy.txt", "17clue.txt", "hardest.txt"}) {
+        for (const std::string &line: sd_test::corpus(name, 200)) {
+            const sd::Board puzzle = sd_test::board_of(line);
+            check_round_trip(puzzle);
+
+            sd::Board solution = puzzle;
+            SD_CHECK(sd::solve(solution, workspace));
+            check_round_trip(solution); // the last cell is confirmed here, so its nibble is non-zero
+
+            uint8_t packed[sd::packed_size];
+            sd::pack(puzzle, packed);
+            SD_CHECK(sd::solve_packed(packed, workspace) == sd::Status::solved);
+            sd::Board solved{};
+            SD_CHECK(sd::unpack(packed, solved));
+            SD_CHECK(same_cells(solved, solution));
+        }
+    }
+
+    // Every way a buffer can be malformed: a nibble above 9 anywhere, or a non-zero final high nibble
+    sd::Board empty{};
+    empty.load(std::string(81, '.').c_str());
+    uint8_t valid[sd::packed_size];
+    sd::pack(empty, valid);
+    for (std::size_t byte = 0; byte < sd::packed_size; ++byte) {
+        for (const uint8_t bad: {0x0A, 0x0F, 0xA0, 0xF0, 0x10}) {
+            if (bad == 0x10 && byte != 40) continue; // a digit 1 in an odd cell is only wrong past cell 80
+            uint8_t buffer[sd::packed_size];
+            std::memcpy(buffer, valid, sd::packed_size);
+            buffer[byte] = bad;
+            sd::Board board{};
+            SD_CHECK(!sd::unpack(buffer, board));
+            SD_CHECK(sd::solve_packed(buffer, workspace) == sd::Status::invalid_puzzle);
+        }
+    }
+    uint8_t last[sd::packed_size];
+    std::memcpy(last, valid, sd::packed_size);
+    last[40] = 9;
+    sd::Board board{};
+    SD_CHECK(sd::unpack(last, board));
+    SD_CHECK(board.cells[80].getConfirmedValue() == 9);
+    return sd_test::finish();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file sd_search_test.cpp
+ * @brief <code>SolveLimits</code> and the resumable search: limits stop early, resumes enumerate every solution.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <set>
+
+#include "sd_test.hpp"
+
+namespace {
+    std::string key_of(const sd::Board &board) {
+        std::string key(81, '.');
+        for (uint8_t i = 0; i < 81; ++i)
+            if (board.cells[i].isConfirmed()) key[i] = static_cast<char>('0' + board.cells[i].getConfirmedValue());
+        return key;
+    }
+
+    /// A corpus puzzle with clues dropped, from the front, until it has between 20 and 2000 solutions
+    sd::Board multi_solution_puzzle(sd::SolverWorkspace &workspace, uint32_t &count) {
+        sd::Board puzzle = sd_test::board_of(sd_test::corpus("hardest.txt", 1).front());
+        for (uint8_t i = 0; i < 81; ++i) {
+            if (!puzzle.cells[i].isConfirmed()) continue;
+            std::string line = key_of(puzzle);
+            line[i] = '.';
+            const sd::Board fewer = sd_test::board_of(line);
+            const uint32_t solutions = sd::count_solutions(fewer, 2001, workspace);
+            if (solutions > 2000) break;
+            puzzle = fewer;
+            count = solutions;
+            if (solutions >= 20) break;
+        }
+        return puzzle;
+    }
+
+    /// Resume a search of <code>puzzle</code> until exhausted; the number of distinct valid solutions it found
+    std::size_t enumerate(const sd::Board &puzzle, const uint64_t max_nodes, uint32_t &pauses) {
+        static sd::SearchState state{}, handed{};
+        sd::start_search(state, puzzle);
+        std::set<std::string> seen;
+        sd::SolveLimits limits{};
+        limits.max_nodes = max_nodes;
+        for (;;) {
+            sd::Board solution{};
+            // Hand the state over as bytes between resumes, as a worker pool would
+            std::memcpy(&handed, &state, sizeof state);
+            const sd::Status status = sd::resume_search(handed, solution, sd::SolveOptions{}, limits);
+            std::memcpy(&state, &handed, sizeof state);
+            if (status == sd::Status::unsolvable) break;
+            if (status == sd::Status::limit_reached) {
+                ++pauses;
+                continue;
+            }
+            SD_CHECK(status == sd::Status::solved);
+            SD_CHECK(sd_test::is_solution_of(solution, puzzle));
+            SD_CHECK(seen.insert(key_of(solution)).second);
+        }
+        SD_CHECK(state.exhausted());
+        sd::Board after{};
+        SD_CHECK(sd::resume_search(state, after) == sd::Status::unsolvable);
+        return seen.size();
+    }
+}
+
+int main() {
+    static sd::SolverWorkspace workspace{};
+
+    // Puzzles that need well over one poll interval (64 guesses) under every engine
+    std::vector<sd::Board> hard;
+    for (const std::string &line: sd_test::corpus("hardest.txt")) {
+        sd::Board board = sd_test::board_of(line);
+        sd::SolveStats stats{};
+        SD_CHECK(sd::solve(board, workspace, sd::SolveOptions{}, stats));
+        if (stats.guesses >= 400) hard.push_back(sd_test::board_of(line));
+    }
+    SD_CHECK(!hard.empty());
+
+    std::atomic<bool> cancelled{true};
+    for (const auto engine: {sd::SearchEngine::copy, sd::SearchEngine::trail, sd::SearchEngine::dlx,
+                             sd::SearchEngine::automatic}) {
+        sd::SolveOptions options{};
+        options.engine = engine;
+        options.branching = sd::Branching::linear; // weaker than the defaults the puzzles were picked with
+        options.deduction = sd::DeductionLevel::naked_singles;
+        for (const sd::Board &puzzle: hard) {
+            sd::SolveLimits by_nodes{};
+            by_nodes.max_nodes = 1;
+            sd::SolveLimits by_cancel{};
+            by_cancel.cancel = &cancelled;
+            for (const sd::SolveLimits &limits: {by_nodes, sd::SolveLimits::within(std::chrono::seconds{0}), by_cancel}) {
+                sd::Board board = puzzle;
+                SD_CHECK(sd::solve(board, workspace, options, limits) == sd::Status::limit_reached);
+                SD_CHECK(key_of(board) == key_of(puzzle)); // left as given
+                SD_CHECK(workspace.nodes < 64 + 64);
+            }
+
+            sd::Board board = puzzle;
+            SD_CHECK(sd::solve(board, workspace, options, sd::SolveLimits::within(std::chrono::minutes{1})) ==
+                     sd::Status::solved);
+            SD_CHECK(sd_test::is_solution_of(board, puzzle));
+        }
+    }
+
+    // Resuming until exhausted yields exactly the solutions count_solutions() finds, each once
+    uint32_t count = 0;
+    const sd::Board several = multi_solution_puzzle(workspace, count);
+    SD_CHECK(count >= 20);
+    uint32_t pauses = 0;
+    SD_CHECK(enumerate(several, 0, pauses) == count);
+    SD_CHECK(pauses == 0);
+    SD_CHECK(enumerate(several, 1, pauses) == count);
+    SD_CHECK(enumerate(hard.front(), 1, pauses) == 1);
+    SD_CHECK(pauses > 0); // a one-guess budget pauses the hard puzzle at every poll
+    return sd_test::finish();
+}
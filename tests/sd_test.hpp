@@ -0,0 +1,89 @@
+/**
+ * @file sd_test.hpp
+ * @brief Check macro, corpus loader and solution checker shared by the unit tests.
+ *
+ * <p>
+ * Every test is one executable whose <code>main()</code> runs its checks and
+ * returns <code>sd_test::finish()</code>: 0 when all passed, 1 otherwise. A
+ * failed <code>SD_CHECK</code> reports its expression and line on
+ * <code>stderr</code> and the test carries on, so one run lists every failure.
+ * </p>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sudok_solver.hpp"
+
+#ifndef SUDOKLITE_TEST_CORPORA
+#define SUDOKLITE_TEST_CORPORA "bench/corpora"
+#endif
+
+#define SD_CHECK(expr) ::sd_test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+namespace sd_test {
+    inline int &failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline void check(const bool ok, const char *expr, const char *file, const int line) {
+        if (ok) return;
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        ++failures();
+    }
+
+    inline int finish() {
+        if (failures()) std::fprintf(stderr, "%d check(s) failed\n", failures());
+        return failures() ? 1 : 0;
+    }
+
+    /// The first <code>limit</code> puzzle lines of a bundled corpus (e.g. "hardest.txt")
+    inline std::vector<std::string> corpus(const char *name, const std::size_t limit = 1000) {
+        std::vector<std::string> lines;
+        std::ifstream in(std::string(SUDOKLITE_TEST_CORPORA) + "/" + name);
+        std::string line;
+        while (lines.size() < limit && std::getline(in, line))
+            if (line.size() >= 81) lines.push_back(line.substr(0, 81));
+        check(!lines.empty(), "corpus is readable", name, 0);
+        return lines;
+    }
+
+    inline sd::Board board_of(const std::string &line) {
+        sd::Board board{};
+        board.load(line.c_str());
+        return board;
+    }
+
+    /// Whether <code>board</code> is complete, every unit a permutation, with the givens of <code>puzzle</code>
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    bool is_solution_of(const sd::BasicBoard<BoxRows, BoxCols, Units> &board,
+                        const sd::BasicBoard<BoxRows, BoxCols, Units> &puzzle) {
+        using board_type = sd::BasicBoard<BoxRows, BoxCols, Units>;
+        constexpr uint8_t size = board_type::size;
+        constexpr uint32_t all_digits = ((uint32_t{1} << size) - 1) << 1;
+        const auto bit = [&board](const int row, const int col) -> uint32_t {
+            const auto &cell = board.cells[row * size + col];
+            const uint32_t mask = cell.possibleMask();
+            return cell.isConfirmed() && (mask & (mask - 1)) == 0 ? mask : 0;
+        };
+        for (int i = 0; i < size; ++i) {
+            uint32_t row = 0, col = 0, box = 0;
+            for (int j = 0; j < size; ++j) {
+                row |= bit(i, j);
+                col |= bit(j, i);
+                box |= bit(i / BoxRows * BoxRows + j / BoxCols, i % BoxRows * BoxCols + j % BoxCols);
+            }
+            if (row != all_digits || col != all_digits || box != all_digits) return false;
+        }
+        for (int i = 0; i < board_type::cell_count; ++i)
+            if (puzzle.cells[i].isConfirmed() && puzzle.cells[i].possibleMask() != board.cells[i].possibleMask())
+                return false;
+        return true;
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ * @file sd_variants_test.cpp
+ * @brief Other board sizes and unit-set policies: every engine agrees on X-Sudoku, killer, jigsaw, 4x4 and 16x16.
+ */
+
+#include <string>
+
+#include "sd_test.hpp"
+
+namespace {
+    constexpr sd::SearchEngine engines[] = {sd::SearchEngine::copy, sd::SearchEngine::trail, sd::SearchEngine::dlx,
+                                            sd::SearchEngine::automatic};
+
+    sd::SolveOptions with(const sd::SearchEngine engine) {
+        sd::SolveOptions options{};
+        options.engine = engine;
+        return options;
+    }
+
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    bool same_cells(const sd::BasicBoard<BoxRows, BoxCols, Units> &a, const sd::BasicBoard<BoxRows, BoxCols, Units> &b) {
+        for (uint16_t i = 0; i < sd::BasicBoard<BoxRows, BoxCols, Units>::cell_count; ++i)
+            if (a.cells[i].state != b.cells[i].state) return false;
+        return true;
+    }
+
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    sd::BasicBoard<BoxRows, BoxCols, Units> empty_board() {
+        sd::BasicBoard<BoxRows, BoxCols, Units> board{};
+        board.load(std::string(sd::BasicBoard<BoxRows, BoxCols, Units>::cell_count, '.').c_str());
+        return board;
+    }
+
+    /// A 9x9 board with clues emptied, from the first cell on, while it keeps a single solution
+    template<typename Units>
+    sd::BasicBoard<3, 3, Units> thin_out(sd::BasicBoard<3, 3, Units> board, sd::BasicWorkspace<3, 3, Units> &workspace) {
+        std::string text(81, '.');
+        for (uint8_t i = 0; i < 81; ++i)
+            if (board.cells[i].isConfirmed()) text[i] = static_cast<char>('0' + board.cells[i].getConfirmedValue());
+        for (uint8_t i = 0; i < 81; ++i) {
+            if (text[i] == '.') continue;
+            const char clue = text[i];
+            text[i] = '.';
+            sd::BasicBoard<3, 3, Units> fewer{};
+            fewer.load(text.c_str());
+            if (sd::count_solutions(fewer, 2, workspace) == 1) board = fewer;
+            else text[i] = clue;
+        }
+        return board;
+    }
+
+    /// Solve with every engine: each must find a valid solution, the same one when it is unique
+    template<uint8_t BoxRows, uint8_t BoxCols, typename Units>
+    void check_engines_agree(const sd::BasicBoard<BoxRows, BoxCols, Units> &puzzle,
+                             sd::BasicWorkspace<BoxRows, BoxCols, Units> &workspace, const uint32_t limit) {
+        const uint32_t count = sd::count_solutions(puzzle, limit, workspace, with(sd::SearchEngine::trail));
+        SD_CHECK(count > 0);
+        sd::BasicBoard<BoxRows, BoxCols, Units> reference = puzzle;
+        SD_CHECK(sd::solve(reference, workspace, with(sd::SearchEngine::trail)));
+        for (const auto engine: engines) {
+            SD_CHECK(sd::count_solutions(puzzle, limit, workspace, with(engine)) == count);
+            sd::BasicBoard<BoxRows, BoxCols, Units> board = puzzle;
+            SD_CHECK(sd::solve(board, workspace, with(engine)));
+            SD_CHECK(board.is_solved());
+            SD_CHECK(sd_test::is_solution_of(board, puzzle));
+            if (count == 1) SD_CHECK(same_cells(board, reference));
+        }
+    }
+
+    // ----- killer: horizontal domino cages over a fixed solution grid -----
+
+    constexpr uint8_t pattern_digit(const uint16_t cell) {
+        const uint16_t r = cell / 9, c = cell % 9;
+        return static_cast<uint8_t>((r * 3 + r / 3 + c) % 9 + 1);
+    }
+
+    /// Cells (r, 2k) and (r, 2k + 1) for k < 4 form cage 4r + k; column 8 is uncaged
+    struct DominoKiller : sd::StandardUnits<3, 3> {
+        static constexpr uint8_t cage_count = 36;
+
+        static constexpr uint8_t cage_of(const uint16_t cell) {
+            return cell % 9 == 8 ? no_cage : static_cast<uint8_t>(cell / 9 * 4 + cell % 9 / 2);
+        }
+
+        static constexpr uint16_t cage_sum(const uint8_t cage) {
+            const uint16_t first = static_cast<uint16_t>(cage / 4 * 9 + cage % 4 * 2);
+            return static_cast<uint16_t>(pattern_digit(first) + pattern_digit(first + 1));
+        }
+    };
+
+    // ----- jigsaw: the box map written out as an explicit region table -----
+
+    struct IdentityJigsaw : sd::StandardUnits<3, 3> {
+        static constexpr uint8_t regions[81] = {
+            0, 0, 0, 1, 1, 1, 2, 2, 2,
+            0, 0, 0, 1, 1, 1, 2, 2, 2,
+            0, 0, 0, 1, 1, 1, 2, 2, 2,
+            3, 3, 3, 4, 4, 4, 5, 5, 5,
+            3, 3, 3, 4, 4, 4, 5, 5, 5,
+            3, 3, 3, 4, 4, 4, 5, 5, 5,
+            6, 6, 6, 7, 7, 7, 8, 8, 8,
+            6, 6, 6, 7, 7, 7, 8, 8, 8,
+            6, 6, 6, 7, 7, 7, 8, 8, 8,
+        };
+
+        static constexpr uint8_t region(const uint16_t cell) { return regions[cell]; }
+    };
+}
+
+int main() {
+    // 4x4: 288 grids, whatever the engine
+    {
+        static sd::BasicWorkspace<2, 2> workspace{};
+        const auto empty = empty_board<2, 2, sd::StandardUnits<2, 2>>();
+        for (const auto engine: engines) SD_CHECK(sd::count_solutions(empty, 1000, workspace, with(engine)) == 288);
+    }
+
+    // X-Sudoku: a unique puzzle thinned from a solved grid, and the empty grid's first 50 solutions
+    {
+        using units = sd::DiagonalUnits<3, 3>;
+        static sd::BasicWorkspace<3, 3, units> workspace{};
+        auto grid = empty_board<3, 3, units>();
+        SD_CHECK(sd::solve(grid, workspace));
+        uint32_t main = 0, anti = 0;
+        for (uint8_t i = 0; i < 9; ++i) {
+            main |= 1u << grid.cells[i * 10].getConfirmedValue();
+            anti |= 1u << grid.cells[i * 8 + 8].getConfirmedValue();
+        }
+        SD_CHECK(main == 0x3FE && anti == 0x3FE);
+
+        const auto puzzle = thin_out(grid, workspace);
+        check_engines_agree(puzzle, workspace, 2);
+        check_engines_agree(empty_board<3, 3, units>(), workspace, 50);
+    }
+
+    // Killer: the cages alone leave many grids, a few givens make the puzzle unique; dlx falls back to trail
+    {
+        static sd::BasicWorkspace<3, 3, DominoKiller> workspace{};
+        std::string text(81, '.');
+        for (uint16_t i = 0; i < 81; i += 7) text[i] = static_cast<char>('0' + pattern_digit(i));
+        sd::BasicBoard<3, 3, DominoKiller> puzzle{};
+        puzzle.load(text.c_str());
+        SD_CHECK(puzzle.check_initial_valid());
+        check_engines_agree(puzzle, workspace, 50);
+
+        sd::BasicBoard<3, 3, DominoKiller> board = puzzle;
+        SD_CHECK(sd::solve(board, workspace, with(sd::SearchEngine::dlx)));
+        for (uint8_t cage = 0; cage < DominoKiller::cage_count; ++cage) {
+            const uint16_t first = static_cast<uint16_t>(cage / 4 * 9 + cage % 4 * 2);
+            SD_CHECK(board.cells[first].getConfirmedValue() + board.cells[first + 1].getConfirmedValue() ==
+                     DominoKiller::cage_sum(cage));
+        }
+        check_engines_agree(thin_out(board, workspace), workspace, 2);
+    }
+
+    // Jigsaw with the box map as its regions: the same answers and the same search as the classic board
+    {
+        static sd::SolverWorkspace classic{};
+        static sd::BasicWorkspace<3, 3, IdentityJigsaw> workspace{};
+        for (const std::string &line: sd_test::corpus("hardest.txt", 50)) {
+            for (const auto engine: engines) {
+                sd::Board a = sd_test::board_of(line);
+                sd::BasicBoard<3, 3, IdentityJigsaw> b{};
+                b.load(line.c_str());
+                sd::SolveStats sa{}, sb{};
+                SD_CHECK(sd::solve(a, classic, with(engine), sa));
+                SD_CHECK(sd::solve(b, workspace, with(engine), sb));
+                for (uint8_t i = 0; i < 81; ++i) SD_CHECK(a.cells[i].state == b.cells[i].state);
+                SD_CHECK(sa.guesses == sb.guesses);
+            }
+        }
+    }
+
+    // 16x16: an empty board solves with dlx (beyond 9x9), trail and automatic
+    {
+        static sd::BasicWorkspace<4, 4> workspace{};
+        const auto empty = empty_board<4, 4, sd::StandardUnits<4, 4>>();
+        for (const auto engine: {sd::SearchEngine::dlx, sd::SearchEngine::trail, sd::SearchEngine::automatic}) {
+            auto board = empty;
+            SD_CHECK(sd::solve(board, workspace, with(engine)));
+            SD_CHECK(sd_test::is_solution_of(board, empty));
+        }
+    }
+    return sd_test::finish();
+}